@@ -0,0 +1,28 @@
+// RailsCharacterMovementComponent.cpp
+
+#include "Character/RailsCharacterMovementComponent.h"
+
+void URailsCharacterMovementComponent::SetRidingVehicle(AActor *Vehicle) {
+  const bool bWasRiding = IsRiding();
+  RidingVehicle = Vehicle;
+
+  if (Vehicle && !bWasRiding) {
+    // Carried by teleports that keep our floor in place - no need to re-find it every frame
+    bSavedAlwaysCheckFloor = bAlwaysCheckFloor;
+    bAlwaysCheckFloor = false;
+  } else if (!Vehicle && bWasRiding) {
+    bAlwaysCheckFloor = bSavedAlwaysCheckFloor;
+    bForceNextFloorCheck = true;
+
+    // Start base tracking from where we are now, not from where riding began
+    SaveBaseLocation();
+  }
+}
+
+void URailsCharacterMovementComponent::UpdateBasedMovement(float DeltaSeconds) {
+  // The rider system already moved us with the vehicle
+  if (IsRiding()) {
+    return;
+  }
+  Super::UpdateBasedMovement(DeltaSeconds);
+}
@@ -0,0 +1,37 @@
+// RailsCharacterMovementComponent.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "RailsCharacterMovementComponent.generated.h"
+
+/**
+ * Character movement that can ride a rail vehicle.
+ * While riding, the vehicle's motion is applied by the train's rider system
+ * (FRailsRiders), so based movement is skipped and the floor is only
+ * re-checked when the character itself moves.
+ */
+UCLASS()
+class EPOCHRAILS_API URailsCharacterMovementComponent : public UCharacterMovementComponent {
+  GENERATED_BODY()
+
+public:
+  /** Start riding Vehicle (nullptr = stop riding and go back to base tracking) */
+  void SetRidingVehicle(AActor *Vehicle);
+
+  UFUNCTION(BlueprintPure, Category = "Character Movement|Riding")
+  bool IsRiding() const { return RidingVehicle.IsValid(); }
+
+  UFUNCTION(BlueprintPure, Category = "Character Movement|Riding")
+  AActor *GetRidingVehicle() const { return RidingVehicle.Get(); }
+
+protected:
+  virtual void UpdateBasedMovement(float DeltaSeconds) override;
+
+private:
+  TWeakObjectPtr<AActor> RidingVehicle;
+
+  /** bAlwaysCheckFloor before riding started */
+  bool bSavedAlwaysCheckFloor = true;
+};
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Character/RailsPlayerCharacter.h"
+#include "Character/RailsCharacterMovementComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Engine/LocalPlayer.h"
@@ -13,10 +14,13 @@
 #include "InputActionValue.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Train/RailsTrain.h"
+#include "Train/RailsTrainSubsystem.h"
 #include "Interaction/InteractionComponent.h"
 #include "Interaction/InteractableInterface.h"
 
-ARailsPlayerCharacter::ARailsPlayerCharacter() {
+ARailsPlayerCharacter::ARailsPlayerCharacter(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer.SetDefaultSubobjectClass<URailsCharacterMovementComponent>(
+          ACharacter::CharacterMovementComponentName)) {
   // Set this character to call Tick() every frame
   PrimaryActorTick.bCanEverTick = true;
 
@@ -63,6 +67,11 @@ void ARailsPlayerCharacter::BeginPlay() {
   // Setup camera attachment based on configuration
   SetupCameraAttachment();
 
+  // Trains find their passengers through the subsystem
+  if (URailsTrainSubsystem *TrainSubsystem = GetWorld()->GetSubsystem<URailsTrainSubsystem>()) {
+    TrainSubsystem->RegisterPassenger(this);
+  }
+
   // Initialize movement speed
   if (UCharacterMovementComponent *MovementComp = GetCharacterMovement()) {
     MovementComp->MaxWalkSpeed = WalkSpeed;
@@ -80,6 +89,14 @@ void ARailsPlayerCharacter::BeginPlay() {
   }
 }
 
+void ARailsPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  if (URailsTrainSubsystem *TrainSubsystem = GetWorld()->GetSubsystem<URailsTrainSubsystem>()) {
+    TrainSubsystem->UnregisterPassenger(this);
+  }
+
+  Super::EndPlay(EndPlayReason);
+}
+
 void ARailsPlayerCharacter::Tick(float DeltaTime) {
   Super::Tick(DeltaTime);
 
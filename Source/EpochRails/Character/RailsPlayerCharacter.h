@@ -162,12 +162,14 @@ public:
 
 public:
   /** Constructor */
-  ARailsPlayerCharacter();
+  ARailsPlayerCharacter(const FObjectInitializer &ObjectInitializer = FObjectInitializer::Get());
 
 protected:
   /** Called when the game starts or when spawned */
   virtual void BeginPlay() override;
 
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
   /** Called every frame */
   virtual void Tick(float DeltaTime) override;
 
@@ -29,7 +29,10 @@ public class EpochRails : ModuleRules
             "NavigationSystem",         // Navmesh, pathfinding
             
             // ==========  ==========
-            "PhysicsCore"               //  
+            "PhysicsCore",              //  
+
+            // ========== Network ==========
+            "NetCore"                   // Fast array replication
         });
 
         PrivateDependencyModuleNames.AddRange(new string[]
@@ -0,0 +1,69 @@
+// RailsConsist.cpp
+
+#include "RailsConsist.h"
+
+#include "RailsWagon.h"
+
+void FRailsConsist::Rebuild(const TArray<TObjectPtr<ARailsWagon>> &AttachedWagons) {
+  Reset();
+
+  Wagons.Reserve(AttachedWagons.Num());
+  HeadOffsets.Reserve(AttachedWagons.Num());
+  Positions.Reserve(AttachedWagons.Num());
+
+  double Offset = 0.0;
+  for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
+    if (!Wagon) {
+      continue;
+    }
+    Offset += Wagon->GetFollowDistance();
+
+    Wagons.Add(Wagon);
+    HeadOffsets.Add(Offset);
+    Positions.Add(Wagon->GetTrackPosition());
+  }
+  Poses.SetNum(Wagons.Num());
+
+  // History must reach back to the last wagon
+  History.Configure(HistorySampleSpacing, Offset);
+}
+
+void FRailsConsist::Reset() {
+  Wagons.Reset();
+  HeadOffsets.Reset();
+  Positions.Reset();
+  Poses.Reset();
+}
+
+void FRailsConsist::SetHistorySampleSpacing(float Spacing) {
+  HistorySampleSpacing = Spacing;
+  History.Configure(HistorySampleSpacing, HeadOffsets.Num() > 0 ? HeadOffsets.Last() : 0.0);
+}
+
+void FRailsConsist::RecordHead(double HeadDistance, const FRailsRoute *InRoute) {
+  History.Record(HeadDistance);
+  Route = InRoute;
+}
+
+void FRailsConsist::EvaluatePose(int32 Index) {
+  // Every wagon resolves independently - exact coupler spacing, no chain lag
+  Positions[Index] = Route->Resolve(History.ResolveDistanceBehind(HeadOffsets[Index]));
+  Poses[Index] = FRailsRoute::GetTransformAt(Positions[Index]);
+}
+
+void FRailsConsist::ApplyPoses() {
+  if (!Route) {
+    return;
+  }
+  for (int32 i = 0; i < Wagons.Num(); ++i) {
+    Wagons[i]->ApplyConsistPose(Positions[i], Poses[i]);
+  }
+}
+
+void FRailsConsist::Update(double HeadDistance, const FRailsRoute &InRoute) {
+  RecordHead(HeadDistance, &InRoute);
+  for (int32 i = 0; i < Wagons.Num(); ++i) {
+    EvaluatePose(i);
+  }
+  ApplyPoses();
+}
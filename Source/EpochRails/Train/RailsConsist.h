@@ -0,0 +1,75 @@
+// RailsConsist.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsPathHistory.h"
+#include "RailsTrackRoute.h"
+
+class ARailsWagon;
+
+/**
+ * Per-train wagon state kept in flat arrays.
+ * ARailsTrain updates the whole consist in one pass instead of every wagon
+ * ticking on its own and pulling its leader's distance. Each wagon sits at a
+ * fixed arc-length offset behind the head, resolved from the head's recorded
+ * path history, so no wagon depends on the one in front of it. Distances are
+ * route distances; the route turns them into (segment, distance), so wagons
+ * follow the head through every switch it took.
+ *
+ * An update is split in three steps so URailsTrainSubsystem can spread the
+ * middle one over worker threads:
+ *   RecordHead (game thread) -> EvaluatePose (any thread, per wagon) -> ApplyPoses (game thread)
+ */
+struct EPOCHRAILS_API FRailsConsist {
+  /** Rebuild the arrays from the train's wagon list (front to back) */
+  void Rebuild(const TArray<TObjectPtr<ARailsWagon>> &AttachedWagons);
+
+  void Reset();
+
+  int32 Num() const { return Wagons.Num(); }
+  ARailsWagon *GetWagon(int32 Index) const { return Wagons[Index]; }
+
+  /** Pose of a wagon as last evaluated, facing the direction of the route */
+  const FTransform &GetPose(int32 Index) const { return Poses[Index]; }
+
+  /** Arc length from the head to the last wagon */
+  double GetLength() const { return HeadOffsets.Num() > 0 ? HeadOffsets.Last() : 0.0; }
+
+  /** Spacing of the head history samples (cm of travel) */
+  void SetHistorySampleSpacing(float Spacing);
+
+  /** Restart the head history after a teleport or path change */
+  void ResetHistory(double HeadDistance) { History.Reset(HeadDistance); }
+
+  /** Record the head's route distance and the route the poses will be evaluated on */
+  void RecordHead(double HeadDistance, const FRailsRoute *InRoute);
+
+  /** Compute one wagon's distance and pose. Reads only immutable path data. */
+  void EvaluatePose(int32 Index);
+
+  /** Move every wagon to its evaluated pose */
+  void ApplyPoses();
+
+  /** RecordHead + EvaluatePose for every wagon + ApplyPoses on the calling thread */
+  void Update(double HeadDistance, const FRailsRoute &InRoute);
+
+private:
+  /** Wagons in chain order - lifetime is owned by ARailsTrain::AttachedWagons */
+  TArray<ARailsWagon *> Wagons;
+
+  /** Arc length from the head to each wagon (sum of follow distances in front of it) */
+  TArray<double> HeadOffsets;
+
+  /** Current segment and distance of each wagon */
+  TArray<FRailsTrackPosition> Positions;
+
+  /** World pose evaluated for each wagon this frame */
+  TArray<FTransform> Poses;
+
+  FRailsPathHistory History;
+  float HistorySampleSpacing = 100.0f;
+
+  /** Route the current frame's poses are evaluated on (owned by the train) */
+  const FRailsRoute *Route = nullptr;
+};
@@ -0,0 +1,118 @@
+// RailsConsistDynamics.cpp
+
+#include "RailsConsistDynamics.h"
+
+namespace {
+constexpr double Gravity = 9.81;
+
+/** Below this speed (m/s) the consist counts as standing and static friction applies */
+constexpr double StandstillSpeed = 0.001;
+} // namespace
+
+void FRailsConsistDynamics::SetNum(int32 NumVehicles) {
+  Masses.SetNumZeroed(NumVehicles);
+  GradeSines.SetNumZeroed(NumVehicles);
+}
+
+void FRailsConsistDynamics::Reset() {
+  Velocity = 0.0;
+  Acceleration = 0.0;
+  PreviousOdometer = 0.0;
+  Odometer = 0.0;
+  Accumulator = 0.0;
+}
+
+void FRailsConsistDynamics::SumVehicles(const FRailsDynamicsSettings &Settings) {
+  // Flat loops over contiguous floats - vectorises, hundreds of wagons are a few hundred ns
+  double Mass = 0.0;
+  double WeightAlongTrack = 0.0;
+  const int32 Count = Masses.Num();
+  const float *MassData = Masses.GetData();
+  const float *GradeData = GradeSines.GetData();
+  for (int32 i = 0; i < Count; ++i) {
+    Mass += MassData[i];
+    WeightAlongTrack += MassData[i] * GradeData[i];
+  }
+
+  TotalMass = FMath::Max(Mass, 1.0);
+  GradeForce = -Gravity * WeightAlongTrack;
+  RollingResistance = Settings.DavisA * TotalMass / 1000.0;
+  SpeedResistance = Settings.DavisB * TotalMass / 1000.0;
+}
+
+float FRailsConsistDynamics::GetBrakingDeceleration(const FRailsDynamicsSettings &Settings) const {
+  const double Speed = FMath::Abs(Velocity);
+  const double Resistance = RollingResistance + SpeedResistance * Speed + Settings.DavisC * Speed * Speed;
+  return float((Settings.MaxBrakeDeceleration + Resistance / TotalMass) * 100.0);
+}
+
+void FRailsConsistDynamics::Substep(const FRailsDynamicsSettings &Settings, float Throttle, float Brake,
+                                    float SpeedLimit, double Dt) {
+  const double Speed = FMath::Abs(Velocity);
+
+  // Constant effort at low speed, constant power above the crossover
+  double Traction = 0.0;
+  if (Throttle != 0.0f) {
+    const double Effort = FMath::Min(double(Settings.MaxTractiveEffort), Settings.MaxPower / FMath::Max(Speed, 1.0));
+
+    // Fade out towards the limit when driving in the throttle's direction
+    double Taper = 1.0;
+    if (FMath::Sign(Velocity) == FMath::Sign(Throttle)) {
+      const double Limit = SpeedLimit / 100.0;
+      Taper = FMath::Clamp((Limit - Speed) / FMath::Max(double(Settings.TractionTaperSpeed), 0.01), 0.0, 1.0);
+    }
+    Traction = Throttle * Effort * Taper;
+  }
+
+  // Forces that only ever oppose motion (or hold the consist still)
+  const double Resistance = RollingResistance + SpeedResistance * Speed + Settings.DavisC * Speed * Speed;
+  const double Braking = Brake * Settings.MaxBrakeDeceleration * TotalMass;
+  const double Opposing = Resistance + Braking;
+
+  const double Driving = Traction + GradeForce;
+  if (Speed < StandstillSpeed) {
+    // Standing: friction and brakes hold unless the rest overcomes them
+    if (FMath::Abs(Driving) <= Opposing) {
+      Velocity = 0.0;
+      Acceleration = 0.0;
+      return;
+    }
+    Acceleration = (Driving - FMath::Sign(Driving) * Opposing) / TotalMass;
+  } else {
+    Acceleration = (Driving - FMath::Sign(Velocity) * Opposing) / TotalMass;
+  }
+
+  const double NewVelocity = Velocity + Acceleration * Dt;
+
+  // Opposing forces stop the consist, they never push it backwards
+  if (Speed >= StandstillSpeed && FMath::Sign(NewVelocity) != FMath::Sign(Velocity) &&
+      FMath::Abs(Driving) <= Opposing) {
+    Velocity = 0.0;
+  } else {
+    Velocity = NewVelocity;
+  }
+  Odometer += Velocity * Dt;
+}
+
+double FRailsConsistDynamics::Advance(float DeltaTime, const FRailsDynamicsSettings &Settings, float Throttle,
+                                      float Brake, float SpeedLimit) {
+  SumVehicles(Settings);
+
+  const double Step = FMath::Max(double(Settings.SubstepTime), 0.001);
+  Accumulator = FMath::Min(Accumulator + DeltaTime, Step * FMath::Max(Settings.MaxSubsteps, 1));
+  while (Accumulator >= Step) {
+    PreviousOdometer = Odometer;
+    Substep(Settings, FMath::Clamp(Throttle, -1.0f, 1.0f), FMath::Clamp(Brake, 0.0f, 1.0f), SpeedLimit, Step);
+    Accumulator -= Step;
+  }
+
+  // Show the consist between the last two substeps
+  const double Alpha = Accumulator / Step;
+  const double Moved = FMath::Lerp(PreviousOdometer, Odometer, Alpha);
+
+  // Next frame measures from where we show the consist now
+  PreviousOdometer -= Moved;
+  Odometer -= Moved;
+
+  return Moved * 100.0;
+}
@@ -0,0 +1,121 @@
+// RailsConsistDynamics.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsConsistDynamics.generated.h"
+
+/** Traction, braking and resistance of a train (SI units, converted to cm at the edges) */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsDynamicsSettings {
+  GENERATED_BODY()
+
+  /** Starting tractive effort at full throttle (N) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float MaxTractiveEffort = 300000.0f;
+
+  /** Power at the rail (W); above MaxPower / MaxTractiveEffort the effort falls off with speed */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float MaxPower = 3000000.0f;
+
+  /** Traction fades out over this band (m/s) below the speed limit, so cruising at the limit is steady */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.01"))
+  float TractionTaperSpeed = 1.0f;
+
+  /** Deceleration full brakes give the whole consist on level track (m/s^2) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float MaxBrakeDeceleration = 1.0f;
+
+  /** Davis A: speed-independent rolling resistance (N per tonne) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float DavisA = 12.0f;
+
+  /** Davis B: flange and bearing resistance (N per tonne per m/s) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float DavisB = 0.3f;
+
+  /** Davis C: aerodynamic drag of the whole consist (N per (m/s)^2) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.0"))
+  float DavisC = 8.0f;
+
+  /** Fixed integration step (s) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "0.001", UIMax = "0.05"))
+  float SubstepTime = 1.0f / 120.0f;
+
+  /** Simulated time per frame is capped at this many substeps (long hitches slow the train down) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dynamics", meta = (ClampMin = "1"))
+  int32 MaxSubsteps = 16;
+};
+
+/**
+ * Longitudinal motion of one consist, treated as a rigid chain.
+ * Vehicle masses and the grade under each vehicle are kept in flat arrays and
+ * folded into consist totals once per frame; the substeps then only integrate
+ * the summed forces, so the cost of a step does not grow with the wagon count.
+ *
+ * Integration is semi-implicit Euler at SubstepTime with a time accumulator;
+ * the distance handed out per frame is interpolated between the last two
+ * substeps so motion stays smooth at any frame rate.
+ *
+ * Velocity is signed along the route (positive = ahead); distances cm, speeds cm/s.
+ */
+struct EPOCHRAILS_API FRailsConsistDynamics {
+  /** Vehicle 0 is the locomotive, then the wagons front to back */
+  void SetNum(int32 NumVehicles);
+  int32 Num() const { return Masses.Num(); }
+
+  /** Mass of one vehicle (kg) */
+  void SetMass(int32 Index, float Mass) { Masses[Index] = Mass; }
+
+  /** Sine of the track slope under one vehicle, positive when the route climbs */
+  void SetGrade(int32 Index, float GradeSine) { GradeSines[Index] = GradeSine; }
+
+  float GetTotalMass() const { return float(TotalMass); }
+
+  /**
+   * Integrate DeltaTime worth of substeps and return how far (cm) the consist
+   * moved this frame. Throttle -1..1 (sign = direction), Brake 0..1,
+   * SpeedLimit cm/s at which traction has faded out.
+   */
+  double Advance(float DeltaTime, const FRailsDynamicsSettings &Settings, float Throttle, float Brake,
+                 float SpeedLimit);
+
+  /** Current velocity (cm/s) and acceleration of the last substep (cm/s^2) */
+  float GetVelocity() const { return float(Velocity * 100.0); }
+  float GetAcceleration() const { return float(Acceleration * 100.0); }
+
+  /** Deceleration (cm/s^2) full brakes plus resistance give at the current speed */
+  float GetBrakingDeceleration(const FRailsDynamicsSettings &Settings) const;
+
+  /** Stand still and forget the accumulated time */
+  void Reset();
+
+private:
+  /** Fold per-vehicle masses and grades into the totals the substeps use */
+  void SumVehicles(const FRailsDynamicsSettings &Settings);
+
+  void Substep(const FRailsDynamicsSettings &Settings, float Throttle, float Brake, float SpeedLimit, double Dt);
+
+  // Per vehicle
+  TArray<float> Masses;
+  TArray<float> GradeSines;
+
+  // Consist totals for this frame
+  double TotalMass = 1.0;
+  double GradeForce = 0.0;
+  double RollingResistance = 0.0;
+  double SpeedResistance = 0.0;
+
+  // State (SI)
+  double Velocity = 0.0;
+  double Acceleration = 0.0;
+
+  /**
+   * Distance (m) at the last two whole substeps, relative to where the
+   * consist was shown last frame, for interpolation
+   */
+  double PreviousOdometer = 0.0;
+  double Odometer = 0.0;
+
+  double Accumulator = 0.0;
+};
@@ -0,0 +1,118 @@
+// RailsConsistReplication.cpp
+
+#include "RailsConsistReplication.h"
+
+#include "RailsTrain.h"
+#include "RailsWagon.h"
+
+// ===== FRailsConsistWagonArray =====
+
+void FRailsConsistWagonArray::Sync(const TArray<TObjectPtr<ARailsWagon>> &Wagons) {
+  TMap<uint32, int32> Positions;
+  Positions.Reserve(Wagons.Num());
+  for (int32 i = 0; i < Wagons.Num(); ++i) {
+    if (Wagons[i] && Wagons[i]->GetConsistNetId() != 0) {
+      Positions.Add(Wagons[i]->GetConsistNetId(), i);
+    }
+  }
+
+  // Drop wagons that left, re-number the ones that moved
+  bool bRemoved = false;
+  for (int32 i = Items.Num() - 1; i >= 0; --i) {
+    FRailsConsistWagonItem &Item = Items[i];
+    int32 Position = INDEX_NONE;
+    if (!Positions.RemoveAndCopyValue(Item.WagonId, Position)) {
+      Items.RemoveAtSwap(i);
+      bRemoved = true;
+      continue;
+    }
+    if (Item.Position != Position) {
+      Item.Position = Position;
+      MarkItemDirty(Item);
+    }
+  }
+  if (bRemoved) {
+    MarkArrayDirty();
+  }
+
+  // Whatever is left joined the consist
+  for (const TPair<uint32, int32> &Pair : Positions) {
+    FRailsConsistWagonItem &Item = Items.AddDefaulted_GetRef();
+    Item.WagonId = Pair.Key;
+    Item.WagonClass = Wagons[Pair.Value]->GetClass();
+    Item.Position = Pair.Value;
+    MarkItemDirty(Item);
+  }
+}
+
+void FRailsConsistWagonArray::GetOrderedWagons(TArray<const FRailsConsistWagonItem *> &OutItems) const {
+  OutItems.Reset(Items.Num());
+  for (const FRailsConsistWagonItem &Item : Items) {
+    OutItems.Add(&Item);
+  }
+  OutItems.Sort([](const FRailsConsistWagonItem &A, const FRailsConsistWagonItem &B) { return A.Position < B.Position; });
+}
+
+void FRailsConsistWagonArray::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
+
+void FRailsConsistWagonArray::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
+
+void FRailsConsistWagonArray::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
+
+// ===== FRailsConsistStructureArray =====
+
+void FRailsConsistStructureArray::AddStructure(uint32 StructureId, uint32 WagonId, UClass *StructureClass,
+                                               const FTransform &RelativeTransform, AActor *ReplicatedStructure) {
+  FRailsConsistStructureItem &Item = Items.AddDefaulted_GetRef();
+  Item.StructureId = StructureId;
+  Item.WagonId = WagonId;
+  Item.StructureClass = StructureClass;
+  Item.RelativeLocation = RelativeTransform.GetLocation();
+  Item.RelativeRotation = RelativeTransform.Rotator();
+  Item.ReplicatedStructure = ReplicatedStructure;
+  MarkItemDirty(Item);
+  IndexById.Add(StructureId, Items.Num() - 1);
+}
+
+void FRailsConsistStructureArray::RemoveStructure(uint32 StructureId) {
+  int32 Index = INDEX_NONE;
+  if (!IndexById.RemoveAndCopyValue(StructureId, Index)) {
+    return;
+  }
+
+  Items.RemoveAtSwap(Index);
+  if (Items.IsValidIndex(Index)) {
+    IndexById.Add(Items[Index].StructureId, Index);
+  }
+  MarkArrayDirty();
+}
+
+void FRailsConsistStructureArray::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
+
+void FRailsConsistStructureArray::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
+
+void FRailsConsistStructureArray::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize) {
+  if (Owner) {
+    Owner->OnConsistDescriptionReceived();
+  }
+}
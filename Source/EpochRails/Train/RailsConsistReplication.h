@@ -0,0 +1,120 @@
+// RailsConsistReplication.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "RailsConsistReplication.generated.h"
+
+class ARailsTrain;
+class ARailsWagon;
+
+/** One wagon of the replicated consist description */
+USTRUCT()
+struct EPOCHRAILS_API FRailsConsistWagonItem : public FFastArraySerializerItem {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  uint32 WagonId = 0;
+
+  UPROPERTY()
+  TSubclassOf<ARailsWagon> WagonClass;
+
+  /** Index from the front of the consist (item order is not preserved on clients) */
+  UPROPERTY()
+  int32 Position = 0;
+};
+
+/** Wagon order of a train; only added, removed or moved wagons are sent */
+USTRUCT()
+struct EPOCHRAILS_API FRailsConsistWagonArray : public FFastArraySerializer {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<FRailsConsistWagonItem> Items;
+
+  UPROPERTY(NotReplicated)
+  TObjectPtr<ARailsTrain> Owner = nullptr;
+
+  /** Server: match the items to the wagons (by consist net id) and their order */
+  void Sync(const TArray<TObjectPtr<ARailsWagon>> &Wagons);
+
+  /** Items sorted front to back */
+  void GetOrderedWagons(TArray<const FRailsConsistWagonItem *> &OutItems) const;
+
+  void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+  void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+  void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+
+  bool NetDeltaSerialize(FNetDeltaSerializeInfo &DeltaParms) {
+    return FFastArraySerializer::FastArrayDeltaSerialize<FRailsConsistWagonItem, FRailsConsistWagonArray>(
+        Items, DeltaParms, *this);
+  }
+};
+
+template <> struct TStructOpsTypeTraits<FRailsConsistWagonArray> : public TStructOpsTypeTraitsBase2<FRailsConsistWagonArray> {
+  enum { WithNetDeltaSerializer = true };
+};
+
+/**
+ * One structure on a wagon. Non-replicated structures are rebuilt locally on
+ * clients; replicated ones (e.g. interactables) arrive as actors of their own
+ * and are only attached to the client's wagon.
+ */
+USTRUCT()
+struct EPOCHRAILS_API FRailsConsistStructureItem : public FFastArraySerializerItem {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  uint32 StructureId = 0;
+
+  UPROPERTY()
+  uint32 WagonId = 0;
+
+  UPROPERTY()
+  TSubclassOf<AActor> StructureClass;
+
+  /** Placement relative to the wagon (scale is not replicated) */
+  UPROPERTY()
+  FVector_NetQuantize10 RelativeLocation;
+
+  UPROPERTY()
+  FRotator RelativeRotation = FRotator::ZeroRotator;
+
+  /** The structure itself if it replicates; null until it reaches the client */
+  UPROPERTY()
+  TObjectPtr<AActor> ReplicatedStructure = nullptr;
+};
+
+/** Structures on a train's wagons; only placed or removed structures are sent */
+USTRUCT()
+struct EPOCHRAILS_API FRailsConsistStructureArray : public FFastArraySerializer {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<FRailsConsistStructureItem> Items;
+
+  UPROPERTY(NotReplicated)
+  TObjectPtr<ARailsTrain> Owner = nullptr;
+
+  /** Server: StructureId -> index into Items */
+  TMap<uint32, int32> IndexById;
+
+  void AddStructure(uint32 StructureId, uint32 WagonId, UClass *StructureClass, const FTransform &RelativeTransform,
+                    AActor *ReplicatedStructure = nullptr);
+  void RemoveStructure(uint32 StructureId);
+
+  void PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize);
+  void PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize);
+  void PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize);
+
+  bool NetDeltaSerialize(FNetDeltaSerializeInfo &DeltaParms) {
+    return FFastArraySerializer::FastArrayDeltaSerialize<FRailsConsistStructureItem, FRailsConsistStructureArray>(
+        Items, DeltaParms, *this);
+  }
+};
+
+template <>
+struct TStructOpsTypeTraits<FRailsConsistStructureArray> : public TStructOpsTypeTraitsBase2<FRailsConsistStructureArray> {
+  enum { WithNetDeltaSerializer = true };
+};
@@ -0,0 +1,22 @@
+// RailsConsistTemplate.cpp
+
+#include "RailsConsistTemplate.h"
+
+#include "RailsWagon.h"
+
+void URailsConsistTemplate::GetClassesToLoad(TArray<FSoftObjectPath> &OutPaths) const {
+  for (const FRailsTemplateWagon &Wagon : Wagons) {
+    if (!Wagon.WagonClass.IsNull()) {
+      OutPaths.AddUnique(Wagon.WagonClass.ToSoftObjectPath());
+    }
+    for (const FRailsTemplateStructure &Structure : Wagon.Structures) {
+      if (!Structure.StructureClass.IsNull()) {
+        OutPaths.AddUnique(Structure.StructureClass.ToSoftObjectPath());
+      }
+    }
+  }
+}
+
+FPrimaryAssetId URailsConsistTemplate::GetPrimaryAssetId() const {
+  return FPrimaryAssetId(TEXT("RailsConsistTemplate"), GetFName());
+}
@@ -0,0 +1,53 @@
+// RailsConsistTemplate.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "RailsConsistTemplate.generated.h"
+
+class ARailsWagon;
+
+/** Structure spawned onto a wagon when the template is built */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsTemplateStructure {
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consist")
+  TSoftClassPtr<AActor> StructureClass;
+
+  /** Placement relative to the wagon origin */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consist")
+  FTransform RelativeTransform;
+};
+
+/** One wagon of a consist template */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsTemplateWagon {
+  GENERATED_BODY()
+
+  /** Wagon class (empty = the train's DefaultWagonClass) */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consist")
+  TSoftClassPtr<ARailsWagon> WagonClass;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consist")
+  TArray<FRailsTemplateStructure> Structures;
+};
+
+/**
+ * Wagon order and initial cargo of a train, front to back.
+ * Classes are soft references so nothing is loaded until the template is used.
+ */
+UCLASS(BlueprintType)
+class EPOCHRAILS_API URailsConsistTemplate : public UPrimaryDataAsset {
+  GENERATED_BODY()
+
+public:
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Consist")
+  TArray<FRailsTemplateWagon> Wagons;
+
+  /** Every wagon and structure class the template references (duplicates removed) */
+  void GetClassesToLoad(TArray<FSoftObjectPath> &OutPaths) const;
+
+  virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+};
@@ -0,0 +1,58 @@
+// RailsKinematicMotion.cpp
+
+#include "RailsKinematicMotion.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void FRailsKinematicMotion::Initialize(AActor &Owner, TArrayView<UPrimitiveComponent *const> InTriggers) {
+  Triggers.Reset();
+
+  for (UPrimitiveComponent *Trigger : InTriggers) {
+    if (!Trigger) {
+      continue;
+    }
+
+    // Keep the trigger where it is in the world when the root moves; we move it ourselves
+    FTrigger &Entry = Triggers.AddDefaulted_GetRef();
+    Entry.Component = Trigger;
+    Entry.RelativeTransform = Trigger->GetComponentTransform().GetRelativeTransform(Owner.GetActorTransform());
+    Trigger->SetUsingAbsoluteLocation(true);
+    Trigger->SetUsingAbsoluteRotation(true);
+  }
+
+  // Blocking geometry doesn't need overlap events - nothing listens to them
+  Owner.ForEachComponent<UPrimitiveComponent>(false, [&InTriggers](UPrimitiveComponent *Primitive) {
+    if (!InTriggers.Contains(Primitive)) {
+      Primitive->SetGenerateOverlapEvents(false);
+    }
+  });
+
+  bInitialized = true;
+  SyncTriggers(Owner);
+}
+
+void FRailsKinematicMotion::Move(AActor &Owner, const FTransform &Target, float OverlapUpdateInterval) {
+  Owner.SetActorLocationAndRotation(Target.GetLocation(), Target.GetRotation(), false, nullptr,
+                                    ETeleportType::TeleportPhysics);
+
+  const UWorld *World = Owner.GetWorld();
+  const double Now = World ? World->GetTimeSeconds() : 0.0;
+  if (Now - LastOverlapUpdateTime >= OverlapUpdateInterval) {
+    SyncTriggers(Owner);
+  }
+}
+
+void FRailsKinematicMotion::SyncTriggers(AActor &Owner) {
+  const FTransform &OwnerTransform = Owner.GetActorTransform();
+  for (const FTrigger &Trigger : Triggers) {
+    if (UPrimitiveComponent *Component = Trigger.Component.Get()) {
+      // The only move the trigger gets - this is where its overlaps are updated
+      Component->SetWorldTransform(Trigger.RelativeTransform * OwnerTransform);
+    }
+  }
+
+  const UWorld *World = Owner.GetWorld();
+  LastOverlapUpdateTime = World ? World->GetTimeSeconds() : 0.0;
+}
@@ -0,0 +1,38 @@
+// RailsKinematicMotion.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Sweep-free movement for rail vehicles.
+ * A vehicle can't leave the rail, so it is teleported onto its pose instead of
+ * swept through the world. Blocking meshes stop generating overlap events, and
+ * overlap-only triggers are decoupled from the root and re-synced at a lower
+ * rate, so a move costs one transform update instead of a sweep plus overlap
+ * queries for the whole component hierarchy.
+ */
+struct EPOCHRAILS_API FRailsKinematicMotion {
+  /** Switch the owner's components to kinematic mode. Triggers keep overlap events. */
+  void Initialize(AActor &Owner, TArrayView<UPrimitiveComponent *const> Triggers);
+
+  bool IsInitialized() const { return bInitialized; }
+
+  /** Teleport the owner to Target; re-sync triggers if OverlapUpdateInterval has elapsed */
+  void Move(AActor &Owner, const FTransform &Target, float OverlapUpdateInterval);
+
+  /** Snap triggers to the owner and let them update overlaps now */
+  void SyncTriggers(AActor &Owner);
+
+private:
+  struct FTrigger {
+    TWeakObjectPtr<UPrimitiveComponent> Component;
+    FTransform RelativeTransform;
+  };
+
+  TArray<FTrigger> Triggers;
+  double LastOverlapUpdateTime = 0.0;
+  bool bInitialized = false;
+};
@@ -0,0 +1,30 @@
+// RailsLeanWagon.cpp
+
+#include "RailsLeanWagon.h"
+
+#include "Components/BoxComponent.h"
+
+ARailsLeanWagon::ARailsLeanWagon(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer.DoNotCreateDefaultSubobject(ARailsWagon::MovementComponentName)
+                .DoNotCreateDefaultSubobject(ARailsWagon::PlatformTriggerComponentName)
+                .DoNotCreateDefaultSubobject(ARailsWagon::BuildableZoneComponentName)) {
+  // Moved by the consist update (AttachToLeader turns the tick on when standalone); never possessed
+  PrimaryActorTick.bStartWithTickEnabled = false;
+  AutoPossessAI = EAutoPossessAI::Disabled;
+  AIControllerClass = nullptr;
+  SetCanBeDamaged(false);
+
+  bKinematicMovement = true;
+}
+
+void ARailsLeanWagon::BeginPlay() {
+  // Created before Super::BeginPlay so kinematic motion picks it up as a trigger
+  if (bCreatePlatformTrigger && !PlatformTrigger) {
+    PlatformTrigger = NewObject<UBoxComponent>(this, ARailsWagon::PlatformTriggerComponentName);
+    PlatformTrigger->SetupAttachment(Root);
+    ConfigurePlatformTrigger(PlatformTrigger);
+    PlatformTrigger->RegisterComponent();
+  }
+
+  Super::BeginPlay();
+}
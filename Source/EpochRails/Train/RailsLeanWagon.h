@@ -0,0 +1,35 @@
+// RailsLeanWagon.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsWagon.h"
+#include "RailsLeanWagon.generated.h"
+
+/**
+ * Lightweight wagon for long consists.
+ * Only the platform mesh and couplers are created up front - no movement
+ * component, no buildable zone box, and the platform trigger is only created
+ * when bCreatePlatformTrigger is set. Driven kinematically by its train's
+ * consist; it only ticks when linked standalone through AttachToLeader.
+ *
+ * Still an APawn through ARailsWagon: the train, consist, pool and replication
+ * all deal in ARailsWagon, and BP_RailsWagon and placed wagons are pawn
+ * assets, so a plain-actor lean wagon would mean splitting ARailsWagon into an
+ * actor base first. The pawn parts left here are inert - no controller is
+ * spawned, there is no movement component and the tick starts disabled.
+ */
+UCLASS(Blueprintable)
+class EPOCHRAILS_API ARailsLeanWagon : public ARailsWagon {
+  GENERATED_BODY()
+
+public:
+  ARailsLeanWagon(const FObjectInitializer &ObjectInitializer = FObjectInitializer::Get());
+
+  virtual void BeginPlay() override;
+
+protected:
+  /** Create the platform trigger at BeginPlay (needed for overlap-based passenger detection) */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wagon|Platform")
+  bool bCreatePlatformTrigger = false;
+};
@@ -0,0 +1,97 @@
+// RailsOccupancyGrid.cpp
+
+#include "RailsOccupancyGrid.h"
+
+namespace {
+// Shrink boxes slightly so structures sharing a face do not claim each other's cells
+constexpr float OccupancyTolerance = 0.5f;
+} // namespace
+
+void FRailsOccupancyGrid::Initialize(const FBox &InBounds, float InCellSize) {
+  Bounds = InBounds;
+  CellSize = FMath::Max(InCellSize, 1.0f);
+  InvCellSize = 1.0f / CellSize;
+
+  const FVector Size = Bounds.GetSize();
+  Dimensions = FIntVector(FMath::Max(1, FMath::CeilToInt(Size.X * InvCellSize)),
+                          FMath::Max(1, FMath::CeilToInt(Size.Y * InvCellSize)),
+                          FMath::Max(1, FMath::CeilToInt(Size.Z * InvCellSize)));
+
+  Cells.Reset();
+  Cells.SetNumZeroed(Dimensions.X * Dimensions.Y * Dimensions.Z);
+}
+
+void FRailsOccupancyGrid::Clear() {
+  FMemory::Memzero(Cells.GetData(), Cells.Num());
+}
+
+bool FRailsOccupancyGrid::GetCellRange(const FBox &Box, FIntVector &OutMin, FIntVector &OutMax) const {
+  if (!IsInitialized() || !Box.IsValid) {
+    return false;
+  }
+
+  const FVector Min = (Box.Min - Bounds.Min + FVector(OccupancyTolerance)) * InvCellSize;
+  const FVector Max = (Box.Max - Bounds.Min - FVector(OccupancyTolerance)) * InvCellSize;
+  if (Max.X < 0.0f || Max.Y < 0.0f || Max.Z < 0.0f || Min.X >= Dimensions.X || Min.Y >= Dimensions.Y ||
+      Min.Z >= Dimensions.Z || Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z) {
+    return false;
+  }
+
+  OutMin = FIntVector(FMath::Clamp(FMath::FloorToInt(Min.X), 0, Dimensions.X - 1),
+                      FMath::Clamp(FMath::FloorToInt(Min.Y), 0, Dimensions.Y - 1),
+                      FMath::Clamp(FMath::FloorToInt(Min.Z), 0, Dimensions.Z - 1));
+  OutMax = FIntVector(FMath::Clamp(FMath::FloorToInt(Max.X), 0, Dimensions.X - 1),
+                      FMath::Clamp(FMath::FloorToInt(Max.Y), 0, Dimensions.Y - 1),
+                      FMath::Clamp(FMath::FloorToInt(Max.Z), 0, Dimensions.Z - 1));
+  return true;
+}
+
+bool FRailsOccupancyGrid::IsFree(const FBox &Box) const {
+  FIntVector Min, Max;
+  if (!GetCellRange(Box, Min, Max)) {
+    return true;
+  }
+
+  for (int32 Z = Min.Z; Z <= Max.Z; ++Z) {
+    for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+      for (int32 X = Min.X; X <= Max.X; ++X) {
+        if (Cells[GetCellIndex(X, Y, Z)] != 0) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void FRailsOccupancyGrid::Add(const FBox &Box) {
+  FIntVector Min, Max;
+  if (!GetCellRange(Box, Min, Max)) {
+    return;
+  }
+
+  for (int32 Z = Min.Z; Z <= Max.Z; ++Z) {
+    for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+      for (int32 X = Min.X; X <= Max.X; ++X) {
+        uint8 &Cell = Cells[GetCellIndex(X, Y, Z)];
+        Cell = Cell < MAX_uint8 ? Cell + 1 : Cell;
+      }
+    }
+  }
+}
+
+void FRailsOccupancyGrid::Remove(const FBox &Box) {
+  FIntVector Min, Max;
+  if (!GetCellRange(Box, Min, Max)) {
+    return;
+  }
+
+  for (int32 Z = Min.Z; Z <= Max.Z; ++Z) {
+    for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+      for (int32 X = Min.X; X <= Max.X; ++X) {
+        uint8 &Cell = Cells[GetCellIndex(X, Y, Z)];
+        Cell = Cell > 0 ? Cell - 1 : 0;
+      }
+    }
+  }
+}
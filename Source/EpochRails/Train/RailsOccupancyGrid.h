@@ -0,0 +1,42 @@
+// RailsOccupancyGrid.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Voxel occupancy of a wagon's buildable zone (wagon local space).
+ * Each cell counts the structure footprints covering it, so placement
+ * validation only touches the cells under the candidate box.
+ */
+struct EPOCHRAILS_API FRailsOccupancyGrid {
+  /** Lay the grid over Bounds with cubic cells of CellSize; clears all occupancy */
+  void Initialize(const FBox &InBounds, float InCellSize);
+
+  /** Mark every cell as empty, keeping the layout */
+  void Clear();
+
+  bool IsInitialized() const { return Cells.Num() > 0; }
+
+  /** True if no cell touched by Box is occupied (parts outside the grid are ignored) */
+  bool IsFree(const FBox &Box) const;
+
+  /** Add / remove one footprint; Remove must be given the same box that was added */
+  void Add(const FBox &Box);
+  void Remove(const FBox &Box);
+
+  const FBox &GetBounds() const { return Bounds; }
+  FIntVector GetDimensions() const { return Dimensions; }
+
+private:
+  /** Cell range covered by Box; false if it misses the grid entirely */
+  bool GetCellRange(const FBox &Box, FIntVector &OutMin, FIntVector &OutMax) const;
+
+  int32 GetCellIndex(int32 X, int32 Y, int32 Z) const { return (Z * Dimensions.Y + Y) * Dimensions.X + X; }
+
+  TArray<uint8> Cells;
+  FBox Bounds = FBox(ForceInit);
+  FIntVector Dimensions = FIntVector::ZeroValue;
+  float CellSize = 0.0f;
+  float InvCellSize = 0.0f;
+};
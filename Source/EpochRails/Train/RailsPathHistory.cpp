@@ -0,0 +1,93 @@
+// RailsPathHistory.cpp
+
+#include "RailsPathHistory.h"
+
+void FRailsPathHistory::Configure(float InSampleSpacing, float CoveredLength) {
+  SampleSpacing = FMath::Max(InSampleSpacing, 1.0f);
+
+  // +2: one sample may sit just ahead of the window start, one is being filled
+  const int32 Capacity = FMath::CeilToInt(CoveredLength / SampleSpacing) + 2;
+  if (Capacity != Samples.Num()) {
+    Samples.SetNum(Capacity);
+    Reset(HeadDistance);
+  }
+}
+
+void FRailsPathHistory::Reset(double InHeadDistance) {
+  if (Samples.Num() == 0) {
+    Samples.SetNum(2);
+  }
+
+  Oldest = 0;
+  Count = 0;
+  HeadOdometer = 0.0;
+  HeadDistance = InHeadDistance;
+  PushSample(0.0, InHeadDistance);
+}
+
+void FRailsPathHistory::PushSample(double Odometer, double PathDistance) {
+  if (Count == Samples.Num()) {
+    // Full - overwrite the oldest sample
+    Oldest = (Oldest + 1) % Samples.Num();
+    --Count;
+  }
+
+  FSample &Sample = Samples[(Oldest + Count) % Samples.Num()];
+  Sample.Odometer = Odometer;
+  Sample.PathDistance = PathDistance;
+  ++Count;
+}
+
+void FRailsPathHistory::Record(double NewHeadDistance) {
+  const double Delta = NewHeadDistance - HeadDistance;
+  const double NewOdometer = HeadOdometer + Delta;
+
+  if (Delta >= 0.0) {
+    // Drop a sample at every spacing boundary crossed since the last record
+    double NextOdometer = GetSample(Count - 1).Odometer + SampleSpacing;
+    while (NextOdometer <= NewOdometer) {
+      const double Alpha = Delta > KINDA_SMALL_NUMBER ? (NextOdometer - HeadOdometer) / Delta : 1.0;
+      PushSample(NextOdometer, FMath::Lerp(HeadDistance, NewHeadDistance, Alpha));
+      NextOdometer += SampleSpacing;
+    }
+  } else {
+    // Reversing - samples ahead of the head no longer describe the path behind it
+    while (Count > 1 && GetSample(Count - 1).Odometer > NewOdometer) {
+      --Count;
+    }
+    if (GetSample(Count - 1).Odometer > NewOdometer) {
+      // Backed up past everything we know - start over from here
+      Reset(NewHeadDistance);
+      return;
+    }
+  }
+
+  HeadOdometer = NewOdometer;
+  HeadDistance = NewHeadDistance;
+}
+
+double FRailsPathHistory::ResolveDistanceBehind(float Offset) const {
+  const double Target = HeadOdometer - Offset;
+
+  // Between the newest sample and the head itself
+  const FSample &Newest = GetSample(Count - 1);
+  if (Target >= Newest.Odometer) {
+    const double Span = HeadOdometer - Newest.Odometer;
+    const double Alpha = Span > KINDA_SMALL_NUMBER ? (Target - Newest.Odometer) / Span : 1.0;
+    return FMath::Lerp(Newest.PathDistance, HeadDistance, Alpha);
+  }
+
+  // Older than anything recorded - extrapolate back along the path
+  const FSample &OldestSample = GetSample(0);
+  if (Target <= OldestSample.Odometer) {
+    return FMath::Max(0.0, OldestSample.PathDistance - (OldestSample.Odometer - Target));
+  }
+
+  // Samples are evenly spaced in odometer, so the bracket is found by index
+  const int32 Age = FMath::Clamp(
+      int32((Target - OldestSample.Odometer) / SampleSpacing), 0, Count - 2);
+  const FSample &A = GetSample(Age);
+  const FSample &B = GetSample(Age + 1);
+  const double Alpha = (Target - A.Odometer) / FMath::Max(B.Odometer - A.Odometer, double(KINDA_SMALL_NUMBER));
+  return FMath::Lerp(A.PathDistance, B.PathDistance, FMath::Clamp(Alpha, 0.0, 1.0));
+}
@@ -0,0 +1,45 @@
+// RailsPathHistory.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ring buffer of where the locomotive has been, sampled at a fixed spacing of
+ * travelled distance (odometer). Any point a given arc length behind the head
+ * is resolved in O(1) by index arithmetic, so every wagon can be placed
+ * independently of the others.
+ */
+struct EPOCHRAILS_API FRailsPathHistory {
+  /** Forget everything and start recording from the given head distance */
+  void Reset(double HeadDistance);
+
+  /** Configure sample spacing and how far behind the head the buffer must reach */
+  void Configure(float InSampleSpacing, float CoveredLength);
+
+  /** Record the head's new distance along the path */
+  void Record(double HeadDistance);
+
+  /** Path distance of the point Offset cm (of travel) behind the head */
+  double ResolveDistanceBehind(float Offset) const;
+
+  double GetHeadDistance() const { return HeadDistance; }
+  double GetHeadOdometer() const { return HeadOdometer; }
+
+private:
+  struct FSample {
+    double Odometer = 0.0;
+    double PathDistance = 0.0;
+  };
+
+  const FSample &GetSample(int32 Age) const { return Samples[(Oldest + Age) % Samples.Num()]; }
+  void PushSample(double Odometer, double PathDistance);
+
+  TArray<FSample> Samples;
+  int32 Oldest = 0;
+  int32 Count = 0;
+  float SampleSpacing = 100.0f;
+
+  double HeadOdometer = 0.0;
+  double HeadDistance = 0.0;
+};
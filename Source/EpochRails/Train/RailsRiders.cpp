@@ -0,0 +1,136 @@
+// RailsRiders.cpp
+
+#include "RailsRiders.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+
+#include "Character/RailsCharacterMovementComponent.h"
+
+bool FRailsRiders::Add(ACharacter *Character, AActor *Vehicle) {
+  if (!Character || !Vehicle) {
+    return false;
+  }
+
+  // Without our movement component base tracking would move the character a second time
+  URailsCharacterMovementComponent *Movement = Cast<URailsCharacterMovementComponent>(Character->GetCharacterMovement());
+  if (!Movement) {
+    return false;
+  }
+
+  if (IndexOf(Character) != INDEX_NONE) {
+    SetVehicle(Character, Vehicle);
+    return true;
+  }
+
+  FRider &Rider = Riders.AddDefaulted_GetRef();
+  Rider.Character = Character;
+  Rider.Vehicle = Vehicle;
+  Rider.LastVehicleTransform = Vehicle->GetActorTransform();
+  Movement->SetRidingVehicle(Vehicle);
+  return true;
+}
+
+void FRailsRiders::Remove(ACharacter *Character) {
+  const int32 Index = IndexOf(Character);
+  if (Index != INDEX_NONE) {
+    Release(Riders[Index]);
+    Riders.RemoveAtSwap(Index);
+  }
+}
+
+void FRailsRiders::SetVehicle(ACharacter *Character, AActor *Vehicle) {
+  const int32 Index = IndexOf(Character);
+  if (Index == INDEX_NONE || !Vehicle || Riders[Index].Vehicle == Vehicle) {
+    return;
+  }
+
+  // Rebase onto the new vehicle; the old one already carried us this frame
+  FRider &Rider = Riders[Index];
+  Rider.Vehicle = Vehicle;
+  Rider.LastVehicleTransform = Vehicle->GetActorTransform();
+  if (URailsCharacterMovementComponent *Movement =
+          Cast<URailsCharacterMovementComponent>(Character->GetCharacterMovement())) {
+    Movement->SetRidingVehicle(Vehicle);
+  }
+}
+
+void FRailsRiders::Carry(float DeltaTime) {
+  for (int32 i = Riders.Num() - 1; i >= 0; --i) {
+    FRider &Rider = Riders[i];
+    ACharacter *Character = Rider.Character.Get();
+    AActor *Vehicle = Rider.Vehicle.Get();
+    if (!Character || !Vehicle) {
+      Release(Rider);
+      Riders.RemoveAtSwap(i);
+      continue;
+    }
+
+    const FTransform VehicleTransform = Vehicle->GetActorTransform();
+    if (VehicleTransform.Equals(Rider.LastVehicleTransform)) {
+      Rider.VehicleVelocity = FVector::ZeroVector;
+      continue;
+    }
+
+    // Simulated proxies get their pose from replication
+    if (Character->GetLocalRole() != ROLE_SimulatedProxy) {
+      // Same local pose, new vehicle frame
+      const FVector OldLocation = Character->GetActorLocation();
+      const FVector NewLocation =
+          VehicleTransform.TransformPosition(Rider.LastVehicleTransform.InverseTransformPosition(OldLocation));
+      const FQuat DeltaRotation = VehicleTransform.GetRotation() * Rider.LastVehicleTransform.GetRotation().Inverse();
+      const float DeltaYaw = DeltaRotation.Rotator().Yaw;
+
+      FRotator NewRotation = Character->GetActorRotation();
+      NewRotation.Yaw += DeltaYaw;
+      Character->SetActorLocationAndRotation(NewLocation, NewRotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+      // Own velocity and view turn with the vehicle
+      if (UCharacterMovementComponent *Movement = Character->GetCharacterMovement()) {
+        Movement->Velocity = DeltaRotation.RotateVector(Movement->Velocity);
+      }
+      if (AController *Controller = Character->GetController()) {
+        FRotator ControlRotation = Controller->GetControlRotation();
+        ControlRotation.Yaw += DeltaYaw;
+        Controller->SetControlRotation(ControlRotation);
+      }
+
+      Rider.VehicleVelocity = DeltaTime > KINDA_SMALL_NUMBER ? (NewLocation - OldLocation) / DeltaTime : FVector::ZeroVector;
+    }
+
+    Rider.LastVehicleTransform = VehicleTransform;
+  }
+}
+
+void FRailsRiders::Reset() {
+  for (FRider &Rider : Riders) {
+    Release(Rider);
+  }
+  Riders.Reset();
+}
+
+void FRailsRiders::ApplyWorldOffset(const FVector &Offset) {
+  // Otherwise the next carry would see the shift as vehicle motion and apply it twice
+  for (FRider &Rider : Riders) {
+    Rider.LastVehicleTransform.AddToTranslation(Offset);
+  }
+}
+
+int32 FRailsRiders::IndexOf(const ACharacter *Character) const {
+  return Riders.IndexOfByPredicate([Character](const FRider &Rider) { return Rider.Character.Get() == Character; });
+}
+
+void FRailsRiders::Release(FRider &Rider) {
+  ACharacter *Character = Rider.Character.Get();
+  if (!Character) {
+    return;
+  }
+
+  if (URailsCharacterMovementComponent *Movement =
+          Cast<URailsCharacterMovementComponent>(Character->GetCharacterMovement())) {
+    Movement->SetRidingVehicle(nullptr);
+
+    // Stepping off a moving train keeps its momentum
+    Movement->Velocity += Rider.VehicleVelocity;
+  }
+}
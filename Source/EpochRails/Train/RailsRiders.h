@@ -0,0 +1,53 @@
+// RailsRiders.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACharacter;
+
+/**
+ * Characters riding a train's vehicles.
+ * Each rider keeps its pose in the frame of the vehicle it stands in; once per
+ * frame, after all vehicles have moved, that pose is composed with the vehicle's
+ * new transform. Replaces character base tracking (floor finds, depenetration)
+ * for passengers, which jitters at high speed.
+ */
+struct EPOCHRAILS_API FRailsRiders {
+  /** Start carrying Character with Vehicle; returns false if the character can't ride */
+  bool Add(ACharacter *Character, AActor *Vehicle);
+
+  /** Stop carrying Character; it keeps the vehicle's velocity */
+  void Remove(ACharacter *Character);
+
+  /** Character walked into another vehicle of the same train */
+  void SetVehicle(ACharacter *Character, AActor *Vehicle);
+
+  /** Move every rider by its vehicle's motion since the last call */
+  void Carry(float DeltaTime);
+
+  /** Release every rider */
+  void Reset();
+
+  /** The world origin moved; riders and vehicles were both shifted already */
+  void ApplyWorldOffset(const FVector &Offset);
+
+  int32 Num() const { return Riders.Num(); }
+
+private:
+  struct FRider {
+    TWeakObjectPtr<ACharacter> Character;
+    TWeakObjectPtr<AActor> Vehicle;
+
+    /** Vehicle transform when the rider was last carried */
+    FTransform LastVehicleTransform;
+
+    /** Velocity of the vehicle at the rider's position during the last carry */
+    FVector VehicleVelocity = FVector::ZeroVector;
+  };
+
+  int32 IndexOf(const ACharacter *Character) const;
+  static void Release(FRider &Rider);
+
+  TArray<FRider> Riders;
+};
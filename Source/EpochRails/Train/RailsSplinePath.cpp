@@ -2,6 +2,128 @@
 #include "RailsSplinePath.h"
 #include "Components/SplineComponent.h"
 #include "Components/SplineMeshComponent.h"
+#include "Algo/BinarySearch.h"
+
+#include "RailsTrackNetwork.h"
+#include "RailsTrackSpatialIndex.h"
+
+// ===== FRailsSplineSampleTable =====
+
+void FRailsSplineSampleTable::Build(const USplineComponent &Spline, float DesiredInterval) {
+  Reset();
+
+  Length = Spline.GetSplineLength();
+  if (Length <= KINDA_SMALL_NUMBER) {
+    return;
+  }
+
+  // Spread samples evenly so the last one lands exactly on the spline end
+  const int32 NumSegments = FMath::Max(1, FMath::CeilToInt(Length / FMath::Max(DesiredInterval, 1.0f)));
+  SampleInterval = Length / NumSegments;
+  InvSampleInterval = 1.0f / SampleInterval;
+
+  Samples.SetNumUninitialized(NumSegments + 1);
+  for (int32 i = 0; i <= NumSegments; ++i) {
+    const float Distance = FMath::Min(i * SampleInterval, Length);
+    const float Key = Spline.GetInputKeyValueAtDistanceAlongSpline(Distance);
+
+    FRailsSplineSample &Sample = Samples[i];
+    Sample.Location = Spline.GetLocationAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+    Sample.Rotation = Spline.GetQuaternionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+    Sample.Tangent = Spline.GetDirectionAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+    Sample.Up = Spline.GetUpVectorAtSplineInputKey(Key, ESplineCoordinateSpace::Local);
+  }
+}
+
+void FRailsSplineSampleTable::Reset() {
+  Samples.Reset();
+  SampleInterval = 0.0f;
+  InvSampleInterval = 0.0f;
+  Length = 0.0f;
+}
+
+void FRailsSplineSampleTable::FindSegment(float Distance, int32 &OutIndex, float &OutAlpha) const {
+  const float Scaled = FMath::Clamp(Distance, 0.0f, Length) * InvSampleInterval;
+  OutIndex = FMath::Clamp(FMath::FloorToInt(Scaled), 0, Samples.Num() - 2);
+  OutAlpha = FMath::Clamp(Scaled - OutIndex, 0.0f, 1.0f);
+}
+
+void FRailsSplineSampleTable::Evaluate(float Distance, FVector &OutLocation, FQuat &OutRotation) const {
+  int32 Index;
+  float Alpha;
+  FindSegment(Distance, Index, Alpha);
+
+  const FRailsSplineSample &A = Samples[Index];
+  const FRailsSplineSample &B = Samples[Index + 1];
+  OutLocation = FMath::Lerp(A.Location, B.Location, Alpha);
+  OutRotation = FQuat::FastLerp(A.Rotation, B.Rotation, Alpha).GetNormalized();
+}
+
+FVector FRailsSplineSampleTable::EvaluateLocation(float Distance) const {
+  int32 Index;
+  float Alpha;
+  FindSegment(Distance, Index, Alpha);
+  return FMath::Lerp(Samples[Index].Location, Samples[Index + 1].Location, Alpha);
+}
+
+FQuat FRailsSplineSampleTable::EvaluateRotation(float Distance) const {
+  int32 Index;
+  float Alpha;
+  FindSegment(Distance, Index, Alpha);
+  return FQuat::FastLerp(Samples[Index].Rotation, Samples[Index + 1].Rotation, Alpha).GetNormalized();
+}
+
+FVector FRailsSplineSampleTable::EvaluateTangent(float Distance) const {
+  int32 Index;
+  float Alpha;
+  FindSegment(Distance, Index, Alpha);
+  return FMath::Lerp(Samples[Index].Tangent, Samples[Index + 1].Tangent, Alpha).GetSafeNormal();
+}
+
+FVector FRailsSplineSampleTable::EvaluateUp(float Distance) const {
+  int32 Index;
+  float Alpha;
+  FindSegment(Distance, Index, Alpha);
+  return FMath::Lerp(Samples[Index].Up, Samples[Index + 1].Up, Alpha).GetSafeNormal();
+}
+
+bool FRailsSplineSampleTable::ProjectLocal(const FVector &LocalLocation, float MinDistance,
+                                           float MaxDistance, float &OutDistance,
+                                           float &OutDistanceSquared) const {
+  const int32 LastSegment = Samples.Num() - 2;
+  const int32 FirstIndex =
+      FMath::Clamp(FMath::FloorToInt(FMath::Max(MinDistance, 0.0f) * InvSampleInterval), 0, LastSegment);
+  const int32 LastIndex =
+      FMath::Clamp(FMath::CeilToInt(FMath::Min(MaxDistance, Length) * InvSampleInterval) - 1, FirstIndex, LastSegment);
+
+  int32 BestIndex = FirstIndex;
+  float BestAlpha = 0.0f;
+  OutDistanceSquared = TNumericLimits<float>::Max();
+
+  for (int32 i = FirstIndex; i <= LastIndex; ++i) {
+    const FVector &A = Samples[i].Location;
+    const FVector Segment = Samples[i + 1].Location - A;
+    const float SegmentLengthSq = Segment.SizeSquared();
+    const float Alpha = SegmentLengthSq > KINDA_SMALL_NUMBER
+                            ? FMath::Clamp(FVector::DotProduct(LocalLocation - A, Segment) / SegmentLengthSq, 0.0f, 1.0f)
+                            : 0.0f;
+    const float DistSq = FVector::DistSquared(LocalLocation, A + Segment * Alpha);
+    if (DistSq < OutDistanceSquared) {
+      OutDistanceSquared = DistSq;
+      BestIndex = i;
+      BestAlpha = Alpha;
+    }
+  }
+
+  OutDistance = FMath::Min((BestIndex + BestAlpha) * SampleInterval, Length);
+
+  // Pinned to the edge of the window - the true answer is probably outside it
+  const bool bOnLowerEdge = BestIndex == FirstIndex && BestAlpha <= 0.0f && FirstIndex > 0;
+  const bool bOnUpperEdge = BestIndex == LastIndex && BestAlpha >= 1.0f && LastIndex < LastSegment;
+  return !bOnLowerEdge && !bOnUpperEdge;
+}
+
+// ===== ARailsSplinePath =====
 
 ARailsSplinePath::ARailsSplinePath() {
   PrimaryActorTick.bCanEverTick = false;
@@ -24,30 +146,529 @@ ARailsSplinePath::ARailsSplinePath() {
                                   ESplineCoordinateSpace::Local);
 }
 
-FVector ARailsSplinePath::GetLocationAtDistance(float Distance) const {
-  if (!SplineComponent)
+void ARailsSplinePath::PostInitializeComponents() {
+  Super::PostInitializeComponents();
+
+  // The table is transient, bake it before anyone starts querying in BeginPlay
+  RebuildSampleTable();
+}
+
+void ARailsSplinePath::BeginPlay() {
+  Super::BeginPlay();
+
+  if (URailsTrackNetwork *Network = GetWorld()->GetSubsystem<URailsTrackNetwork>()) {
+    Network->RegisterPath(this);
+  }
+}
+
+void ARailsSplinePath::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  if (URailsTrackNetwork *Network = GetWorld()->GetSubsystem<URailsTrackNetwork>()) {
+    Network->UnregisterPath(this);
+  }
+  if (URailsTrackSpatialIndex *Index = GetWorld()->GetSubsystem<URailsTrackSpatialIndex>()) {
+    Index->RemovePath(this);
+  }
+
+  Super::EndPlay(EndPlayReason);
+}
+
+void ARailsSplinePath::RebuildSampleTable() {
+  Chunks.Reset();
+  ChunkStarts.Reset();
+  if (!SplineComponent) {
+    return;
+  }
+
+  // Chunk boundaries copy our tangents, so they must match the current points
+  RefreshAuthoringSpline();
+
+  const int32 NumPoints = SplineComponent->GetNumberOfSplinePoints();
+  const int32 PointsPerChunk = FMath::Max(MaxPointsPerChunk, 2);
+
+  if (MaxPointsPerChunk <= 0 || NumPoints <= PointsPerChunk) {
+    // Short path - our own spline is the only chunk
+    for (USplineComponent *ChunkSpline : ChunkSplines) {
+      if (ChunkSpline) {
+        ChunkSpline->DestroyComponent();
+      }
+    }
+    ChunkSplines.Reset();
+
+    FRailsSplineChunk &Chunk = Chunks.AddDefaulted_GetRef();
+    Chunk.Spline = SplineComponent;
+    Chunk.NumPoints = NumPoints;
+    BakeChunk(Chunk, SampleInterval);
+  } else {
+    // Neighbouring chunks share their boundary point
+    const int32 Stride = PointsPerChunk - 1;
+    const int32 NumChunks = FMath::DivideAndRoundUp(NumPoints - 1, Stride);
+
+    while (ChunkSplines.Num() > NumChunks) {
+      if (USplineComponent *ChunkSpline = ChunkSplines.Pop()) {
+        ChunkSpline->DestroyComponent();
+      }
+    }
+    while (ChunkSplines.Num() < NumChunks) {
+      // Same frame as our spline, so both share one local space
+      USplineComponent *ChunkSpline = NewObject<USplineComponent>(this, NAME_None, RF_Transient);
+      ChunkSpline->SetupAttachment(SplineComponent);
+      ChunkSpline->SetClosedLoop(false);
+      ChunkSpline->SetDrawDebug(false);
+      ChunkSpline->SetHiddenInGame(true);
+      if (GetWorld()) {
+        ChunkSpline->RegisterComponent();
+      }
+      ChunkSplines.Add(ChunkSpline);
+    }
+
+    Chunks.SetNum(NumChunks);
+    for (int32 i = 0; i < NumChunks; ++i) {
+      FRailsSplineChunk &Chunk = Chunks[i];
+      Chunk.Spline = ChunkSplines[i];
+      Chunk.FirstPoint = i * Stride;
+      Chunk.NumPoints = FMath::Min(Stride, NumPoints - 1 - Chunk.FirstPoint) + 1;
+      CopyPointsToChunk(*Chunk.Spline, Chunk.FirstPoint, Chunk.FirstPoint + Chunk.NumPoints - 1);
+      BakeChunk(Chunk, SampleInterval);
+    }
+  }
+
+  RefreshChunkStarts();
+  NotifyTrackChanged(0, Chunks.Num() - 1);
+}
+
+void ARailsSplinePath::SetPointLocation(int32 PointIndex, const FVector &Location,
+                                        ESplineCoordinateSpace::Type CoordinateSpace) {
+  if (!SplineComponent || PointIndex < 0 || PointIndex >= SplineComponent->GetNumberOfSplinePoints()) {
+    return;
+  }
+
+  const bool bChunked = ChunkSplines.Num() > 0;
+
+  // Our spline stays the authoring data; a chunked path defers its full reparameterisation
+  // until the next full rebuild or RefreshAuthoringSpline
+  SplineComponent->SetLocationAtSplinePoint(PointIndex, Location, CoordinateSpace, !bChunked);
+  if (!bChunked) {
+    RebuildSampleTable();
+    return;
+  }
+  bAuthoringSplineDirty = true;
+
+  const FVector LocalLocation = CoordinateSpace == ESplineCoordinateSpace::World
+                                    ? SplineComponent->GetComponentTransform().InverseTransformPosition(Location)
+                                    : Location;
+
+  // The chunks holding the point, plus any whose pinned end tangent sees it as a neighbour
+  int32 FirstTouched = INDEX_NONE;
+  int32 LastTouched = INDEX_NONE;
+  for (int32 i = 0; i < Chunks.Num(); ++i) {
+    FRailsSplineChunk &Chunk = Chunks[i];
+    const int32 LastPoint = Chunk.FirstPoint + Chunk.NumPoints - 1;
+    if (PointIndex < Chunk.FirstPoint - 1 || PointIndex > LastPoint + 1) {
+      continue;
+    }
+
+    bool bChanged = false;
+    if (PointIndex >= Chunk.FirstPoint && PointIndex <= LastPoint) {
+      Chunk.Spline->SetLocationAtSplinePoint(PointIndex - Chunk.FirstPoint, LocalLocation,
+                                             ESplineCoordinateSpace::Local, false);
+      bChanged = true;
+    }
+    if (FMath::Abs(PointIndex - Chunk.FirstPoint) <= 1) {
+      bChanged |= RefreshPinnedTangent(*Chunk.Spline, 0, Chunk.FirstPoint);
+    }
+    if (FMath::Abs(PointIndex - LastPoint) <= 1) {
+      bChanged |= RefreshPinnedTangent(*Chunk.Spline, Chunk.NumPoints - 1, LastPoint);
+    }
+    if (!bChanged) {
+      continue;
+    }
+
+    Chunk.Spline->UpdateSpline();
+    BakeChunk(Chunk, SampleInterval);
+    FirstTouched = FirstTouched == INDEX_NONE ? i : FirstTouched;
+    LastTouched = i;
+  }
+
+  RefreshChunkStarts();
+  NotifyTrackChanged(FirstTouched, LastTouched);
+}
+
+void ARailsSplinePath::RefreshAuthoringSpline() {
+  if (bAuthoringSplineDirty && SplineComponent) {
+    bAuthoringSplineDirty = false;
+    SplineComponent->UpdateSpline();
+  }
+}
+
+bool ARailsSplinePath::RefreshPinnedTangent(USplineComponent &ChunkSpline, int32 LocalIndex, int32 PointIndex) const {
+  const ESplinePointType::Type Type = SplineComponent->GetSplinePointType(PointIndex);
+  if (Type != ESplinePointType::Curve && Type != ESplinePointType::CurveClamped) {
+    return false;
+  }
+
+  // Same rule as the full curve's auto tangents (tension 0, one-sided at the path ends)
+  const int32 LastPoint = SplineComponent->GetNumberOfSplinePoints() - 1;
+  const int32 Prev = FMath::Max(PointIndex - 1, 0);
+  const int32 Next = FMath::Min(PointIndex + 1, LastPoint);
+  FVector Tangent = FVector::ZeroVector;
+  if (!SplineComponent->bStationaryEndpoints || (PointIndex > 0 && PointIndex < LastPoint)) {
+    ComputeCurveTangent(float(Prev), SplineComponent->GetLocationAtSplinePoint(Prev, ESplineCoordinateSpace::Local),
+                        float(PointIndex),
+                        SplineComponent->GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local),
+                        float(Next), SplineComponent->GetLocationAtSplinePoint(Next, ESplineCoordinateSpace::Local),
+                        0.0f, Type == ESplinePointType::CurveClamped, Tangent);
+  }
+
+  ChunkSpline.SetTangentsAtSplinePoint(LocalIndex, Tangent, Tangent, ESplineCoordinateSpace::Local, false);
+  return true;
+}
+
+void ARailsSplinePath::CopyPointsToChunk(USplineComponent &ChunkSpline, int32 FirstPoint, int32 LastPoint) const {
+  TArray<FSplinePoint> Points;
+  Points.Reserve(LastPoint - FirstPoint + 1);
+  for (int32 i = FirstPoint; i <= LastPoint; ++i) {
+    FSplinePoint Point = SplineComponent->GetSplinePointAt(i, ESplineCoordinateSpace::Local);
+    Point.InputKey = float(i - FirstPoint);
+
+    // Auto tangents at the cut would only see one neighbour - pin them to the full curve's
+    if (i == FirstPoint || i == LastPoint) {
+      Point.Type = ESplinePointType::CurveCustomTangent;
+      Point.ArriveTangent = SplineComponent->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local);
+      Point.LeaveTangent = SplineComponent->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local);
+    }
+    Points.Add(Point);
+  }
+
+  ChunkSpline.ClearSplinePoints(false);
+  ChunkSpline.AddPoints(Points, true);
+}
+
+void ARailsSplinePath::BakeChunk(FRailsSplineChunk &Chunk, float Interval) {
+  Chunk.Table.Build(*Chunk.Spline, Interval);
+
+  Chunk.Bounds = FBox(ForceInit);
+  for (const FRailsSplineSample &Sample : Chunk.Table.GetSamples()) {
+    Chunk.Bounds += Sample.Location;
+  }
+  Chunk.Bounds = Chunk.Bounds.TransformBy(Chunk.Spline->GetComponentTransform());
+}
+
+void ARailsSplinePath::RefreshChunkStarts() {
+  ChunkStarts.SetNum(Chunks.Num() + 1);
+  double Distance = 0.0;
+  for (int32 i = 0; i < Chunks.Num(); ++i) {
+    ChunkStarts[i] = Distance;
+    Distance += Chunks[i].Table.IsValid() ? Chunks[i].Table.GetLength() : Chunks[i].Spline->GetSplineLength();
+  }
+  ChunkStarts[Chunks.Num()] = Distance;
+}
+
+void ARailsSplinePath::NotifyTrackChanged(int32 FirstChunk, int32 LastChunk) {
+  UWorld *World = GetWorld();
+  if (!World || FirstChunk == INDEX_NONE) {
+    return;
+  }
+
+  // Our ends may have moved, and the touched chunks with them
+  if (URailsTrackNetwork *Network = World->GetSubsystem<URailsTrackNetwork>()) {
+    Network->MarkDirty();
+  }
+  if (URailsTrackSpatialIndex *Index = World->GetSubsystem<URailsTrackSpatialIndex>()) {
+    Index->UpdatePathChunks(this, FirstChunk, LastChunk);
+  }
+}
+
+void ARailsSplinePath::Destroyed() {
+  // Editor deletions never reach EndPlay
+  if (UWorld *World = GetWorld()) {
+    if (URailsTrackSpatialIndex *Index = World->GetSubsystem<URailsTrackSpatialIndex>()) {
+      Index->RemovePath(this);
+    }
+  }
+
+  Super::Destroyed();
+}
+
+void ARailsSplinePath::ApplyWorldOffset(const FVector &InOffset, bool bWorldShift) {
+  Super::ApplyWorldOffset(InOffset, bWorldShift);
+
+  // Baked tables are in spline space and moved with the components; only world data needs shifting
+  for (FRailsSplineChunk &Chunk : Chunks) {
+    Chunk.Bounds = Chunk.Bounds.ShiftBy(InOffset);
+  }
+  NotifyTrackChanged(0, Chunks.Num() - 1);
+}
+
+// ===== Queries =====
+
+int32 ARailsSplinePath::FindChunk(double Distance) const {
+  if (Chunks.Num() == 0) {
+    return INDEX_NONE;
+  }
+
+  // Last chunk starting at or before the distance
+  const int32 Index = Algo::UpperBound(TConstArrayView<double>(ChunkStarts.GetData(), Chunks.Num()), Distance) - 1;
+  return FMath::Clamp(Index, 0, Chunks.Num() - 1);
+}
+
+const FRailsSplineChunk *ARailsSplinePath::ResolveChunk(double Distance, float &OutLocalDistance) const {
+  const int32 Index = FindChunk(Distance);
+  if (Index == INDEX_NONE) {
+    return nullptr;
+  }
+  OutLocalDistance = FMath::Clamp(float(Distance - ChunkStarts[Index]), 0.0f, GetChunkLength(Index));
+  return &Chunks[Index];
+}
+
+FVector ARailsSplinePath::GetLocationAtDistance(double Distance) const {
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  if (!Chunk)
     return FVector::ZeroVector;
-  return SplineComponent->GetLocationAtDistanceAlongSpline(
-      Distance, ESplineCoordinateSpace::World);
+  if (Chunk->Table.IsValid()) {
+    return Chunk->Spline->GetComponentTransform().TransformPosition(Chunk->Table.EvaluateLocation(Local));
+  }
+  return Chunk->Spline->GetLocationAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World);
 }
 
-FRotator ARailsSplinePath::GetRotationAtDistance(float Distance) const {
-  if (!SplineComponent)
+FRotator ARailsSplinePath::GetRotationAtDistance(double Distance) const {
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  if (!Chunk)
     return FRotator::ZeroRotator;
-  return SplineComponent->GetRotationAtDistanceAlongSpline(
-      Distance, ESplineCoordinateSpace::World);
+  if (Chunk->Table.IsValid()) {
+    return Chunk->Spline->GetComponentTransform().TransformRotation(Chunk->Table.EvaluateRotation(Local)).Rotator();
+  }
+  return Chunk->Spline->GetRotationAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World);
 }
 
-float ARailsSplinePath::GetSplineLength() const {
-  if (!SplineComponent)
+FVector ARailsSplinePath::GetDirectionAtDistance(double Distance) const {
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  if (!Chunk)
+    return FVector::ForwardVector;
+  if (Chunk->Table.IsValid()) {
+    return Chunk->Spline->GetComponentTransform().TransformVectorNoScale(Chunk->Table.EvaluateTangent(Local));
+  }
+  return Chunk->Spline->GetDirectionAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World);
+}
+
+FVector ARailsSplinePath::GetUpVectorAtDistance(double Distance) const {
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  if (!Chunk)
+    return FVector::UpVector;
+  if (Chunk->Table.IsValid()) {
+    return Chunk->Spline->GetComponentTransform().TransformVectorNoScale(Chunk->Table.EvaluateUp(Local));
+  }
+  return Chunk->Spline->GetUpVectorAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World);
+}
+
+FTransform ARailsSplinePath::GetTransformAtDistance(double Distance) const {
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  if (!Chunk)
+    return FTransform::Identity;
+
+  const FTransform &ComponentTransform = Chunk->Spline->GetComponentTransform();
+  if (Chunk->Table.IsValid()) {
+    FVector LocalLocation;
+    FQuat LocalRotation;
+    Chunk->Table.Evaluate(Local, LocalLocation, LocalRotation);
+    return FTransform(ComponentTransform.TransformRotation(LocalRotation),
+                      ComponentTransform.TransformPosition(LocalLocation));
+  }
+  return FTransform(Chunk->Spline->GetQuaternionAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World),
+                    Chunk->Spline->GetLocationAtDistanceAlongSpline(Local, ESplineCoordinateSpace::World));
+}
+
+bool ARailsSplinePath::ProjectOntoChunk(const FRailsSplineChunk &Chunk, const FVector &WorldLocation,
+                                        float MinDistance, float MaxDistance, float &OutDistance,
+                                        float &OutDistanceSquared) const {
+  if (!Chunk.Table.IsValid()) {
+    const float Key = Chunk.Spline->FindInputKeyClosestToWorldLocation(WorldLocation);
+    OutDistance = FMath::Clamp(Chunk.Spline->GetDistanceAlongSplineAtSplineInputKey(Key), MinDistance, MaxDistance);
+    OutDistanceSquared = FVector::DistSquared(
+        Chunk.Spline->GetLocationAtDistanceAlongSpline(OutDistance, ESplineCoordinateSpace::World), WorldLocation);
+    return true;
+  }
+
+  const FVector LocalLocation = Chunk.Spline->GetComponentTransform().InverseTransformPosition(WorldLocation);
+  return Chunk.Table.ProjectLocal(LocalLocation, MinDistance, MaxDistance, OutDistance, OutDistanceSquared);
+}
+
+double ARailsSplinePath::FindDistanceClosestToWorldLocationWarm(const FVector &WorldLocation,
+                                                                double HintDistance,
+                                                                float SearchRadius) const {
+  if (Chunks.Num() == 0) {
+    return 0.0;
+  }
+
+  // Only the chunks the window overlaps
+  const double WindowMin = HintDistance - SearchRadius;
+  const double WindowMax = HintDistance + SearchRadius;
+  double BestDistance = 0.0;
+  float BestDistanceSquared = TNumericLimits<float>::Max();
+  bool bConverged = false;
+  for (int32 i = FindChunk(WindowMin); i <= FindChunk(WindowMax); ++i) {
+    float Distance = 0.0f;
+    float DistanceSquared = 0.0f;
+    const bool bChunkConverged = ProjectOntoChunk(Chunks[i], WorldLocation, float(WindowMin - ChunkStarts[i]),
+                                                  float(WindowMax - ChunkStarts[i]), Distance, DistanceSquared);
+    if (DistanceSquared < BestDistanceSquared) {
+      BestDistanceSquared = DistanceSquared;
+      BestDistance = ChunkStarts[i] + Distance;
+      bConverged = bChunkConverged;
+    }
+  }
+
+  // Result jumped (window edge) or the point is too far off the track for the
+  // window to be trusted - do the full search
+  if (!bConverged || BestDistanceSquared > FMath::Square(SearchRadius)) {
+    return FindDistanceClosestToWorldLocation(WorldLocation);
+  }
+  return BestDistance;
+}
+
+float ARailsSplinePath::FindInputKeyClosestToWorldLocationWarm(const FVector &WorldLocation,
+                                                               float HintInputKey,
+                                                               float SearchRadius) const {
+  if (!SplineComponent) {
     return 0.0f;
+  }
+
+  const double HintDistance = GetDistanceAtInputKey(HintInputKey);
+  const double Distance =
+      FindDistanceClosestToWorldLocationWarm(WorldLocation, HintDistance, SearchRadius);
+  return GetInputKeyAtDistance(Distance);
+}
+
+double ARailsSplinePath::FindDistanceClosestToWorldLocation(const FVector &WorldLocation) const {
+  if (!SplineComponent) {
+    return 0.0;
+  }
+
+  if (ChunkSplines.Num() == 0) {
+    const float InputKey = SplineComponent->FindInputKeyClosestToWorldLocation(WorldLocation);
+    return SplineComponent->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+  }
+
+  // Nearest chunks first; stop once no chunk's bounds can hold anything closer
+  TArray<TPair<float, int32>> Order;
+  Order.Reserve(Chunks.Num());
+  for (int32 i = 0; i < Chunks.Num(); ++i) {
+    Order.Emplace(Chunks[i].Bounds.ComputeSquaredDistanceToPoint(WorldLocation), i);
+  }
+  Order.Sort([](const TPair<float, int32> &A, const TPair<float, int32> &B) { return A.Key < B.Key; });
+
+  double BestDistance = 0.0;
+  float BestDistanceSquared = TNumericLimits<float>::Max();
+  for (const TPair<float, int32> &Entry : Order) {
+    if (Entry.Key > BestDistanceSquared) {
+      break;
+    }
+    const int32 i = Entry.Value;
+    float Distance = 0.0f;
+    float DistanceSquared = 0.0f;
+    ProjectOntoChunk(Chunks[i], WorldLocation, 0.0f, GetChunkLength(i), Distance, DistanceSquared);
+    if (DistanceSquared < BestDistanceSquared) {
+      BestDistanceSquared = DistanceSquared;
+      BestDistance = ChunkStarts[i] + Distance;
+    }
+  }
+  return BestDistance;
+}
+
+double ARailsSplinePath::FindDistanceClosestInRange(const FVector &WorldLocation, double MinDistance,
+                                                     double MaxDistance) const {
+  if (Chunks.Num() == 0) {
+    return 0.0;
+  }
+
+  double BestDistance = MinDistance;
+  float BestDistanceSquared = TNumericLimits<float>::Max();
+  for (int32 i = FindChunk(MinDistance); i <= FindChunk(MaxDistance); ++i) {
+    float Distance = 0.0f;
+    float DistanceSquared = 0.0f;
+    ProjectOntoChunk(Chunks[i], WorldLocation, float(MinDistance - ChunkStarts[i]),
+                     float(MaxDistance - ChunkStarts[i]), Distance, DistanceSquared);
+    if (DistanceSquared < BestDistanceSquared) {
+      BestDistanceSquared = DistanceSquared;
+      BestDistance = ChunkStarts[i] + Distance;
+    }
+  }
+  return BestDistance;
+}
+
+FBox ARailsSplinePath::GetBoundsInRange(double MinDistance, double MaxDistance) const {
+  FBox Bounds(ForceInit);
+  if (Chunks.Num() == 0) {
+    return Bounds;
+  }
+
+  for (int32 c = FindChunk(MinDistance); c <= FindChunk(MaxDistance); ++c) {
+    const FRailsSplineChunk &Chunk = Chunks[c];
+    if (!Chunk.Table.IsValid()) {
+      Bounds += Chunk.Bounds;
+      continue;
+    }
+
+    // Samples in the range plus the interpolated points at both ends
+    const float LocalMin = FMath::Max(float(MinDistance - ChunkStarts[c]), 0.0f);
+    const float LocalMax = FMath::Min(float(MaxDistance - ChunkStarts[c]), GetChunkLength(c));
+    const TArray<FRailsSplineSample> &Samples = Chunk.Table.GetSamples();
+    const float Interval = Chunk.Table.GetSampleInterval();
+    const int32 First = FMath::Clamp(FMath::CeilToInt(LocalMin / Interval), 0, Samples.Num() - 1);
+    const int32 Last = FMath::Clamp(FMath::FloorToInt(LocalMax / Interval), 0, Samples.Num() - 1);
+
+    FBox ChunkBounds(ForceInit);
+    ChunkBounds += Chunk.Table.EvaluateLocation(LocalMin);
+    ChunkBounds += Chunk.Table.EvaluateLocation(LocalMax);
+    for (int32 i = First; i <= Last; ++i) {
+      ChunkBounds += Samples[i].Location;
+    }
+    Bounds += ChunkBounds.TransformBy(Chunk.Spline->GetComponentTransform());
+  }
+  return Bounds;
+}
+
+double ARailsSplinePath::GetSplineLength() const {
+  if (ChunkStarts.Num() > 0)
+    return ChunkStarts.Last();
+  if (!SplineComponent)
+    return 0.0;
   return SplineComponent->GetSplineLength();
 }
 
+double ARailsSplinePath::GetDistanceAtInputKey(float InputKey) const {
+  if (ChunkSplines.Num() == 0) {
+    return SplineComponent->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+  }
+
+  // Chunks are a fixed number of points long
+  const int32 Stride = Chunks[0].NumPoints - 1;
+  const int32 Index = FMath::Clamp(FMath::FloorToInt(InputKey / Stride), 0, Chunks.Num() - 1);
+  const FRailsSplineChunk &Chunk = Chunks[Index];
+  return ChunkStarts[Index] + Chunk.Spline->GetDistanceAlongSplineAtSplineInputKey(InputKey - Chunk.FirstPoint);
+}
+
+float ARailsSplinePath::GetInputKeyAtDistance(double Distance) const {
+  if (ChunkSplines.Num() == 0) {
+    return SplineComponent->GetInputKeyValueAtDistanceAlongSpline(float(Distance));
+  }
+
+  float Local = 0.0f;
+  const FRailsSplineChunk *Chunk = ResolveChunk(Distance, Local);
+  return Chunk->FirstPoint + Chunk->Spline->GetInputKeyValueAtDistanceAlongSpline(Local);
+}
+
 #if WITH_EDITOR
 void ARailsSplinePath::OnConstruction(const FTransform &Transform) {
   Super::OnConstruction(Transform);
 
+  // Spline points may have been edited - re-bake the lookup table
+  RebuildSampleTable();
+
   // Update visualization in editor
   if (bShowDebugVisualization && SplineComponent) {
     // Debug visualization is handled by DrawDebugHelpers in Tick or via editor
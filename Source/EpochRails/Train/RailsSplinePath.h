@@ -6,9 +6,83 @@
 #include "GameFramework/Actor.h"
 #include "RailsSplinePath.generated.h"
 
+/** One sample of the baked spline table (spline component space) */
+struct FRailsSplineSample {
+  FVector Location = FVector::ZeroVector;
+  FQuat Rotation = FQuat::Identity;
+  FVector Tangent = FVector::ForwardVector;
+  FVector Up = FVector::UpVector;
+};
+
+/**
+ * Distance -> pose table sampled at an even arc-length interval.
+ * Built once from a spline, then every lookup is an index computation
+ * plus a lerp/slerp between two neighbouring samples.
+ */
+struct EPOCHRAILS_API FRailsSplineSampleTable {
+  /** Rebuild the table from the spline's current shape */
+  void Build(const USplineComponent &Spline, float DesiredInterval);
+
+  void Reset();
+
+  bool IsValid() const { return Samples.Num() >= 2; }
+  float GetLength() const { return Length; }
+  float GetSampleInterval() const { return SampleInterval; }
+  const TArray<FRailsSplineSample> &GetSamples() const { return Samples; }
+
+  /** Local-space location and rotation at distance (clamped to the table) */
+  void Evaluate(float Distance, FVector &OutLocation, FQuat &OutRotation) const;
+
+  FVector EvaluateLocation(float Distance) const;
+  FQuat EvaluateRotation(float Distance) const;
+  FVector EvaluateTangent(float Distance) const;
+  FVector EvaluateUp(float Distance) const;
+
+  /**
+   * Closest point on the sampled polyline to a local-space location,
+   * searching only segments between MinDistance and MaxDistance.
+   * @return false if the best point sits on a window edge that is not a path end
+   */
+  bool ProjectLocal(const FVector &LocalLocation, float MinDistance, float MaxDistance,
+                    float &OutDistance, float &OutDistanceSquared) const;
+
+private:
+  /** Find sample index and blend alpha towards the next sample */
+  void FindSegment(float Distance, int32 &OutIndex, float &OutAlpha) const;
+
+  TArray<FRailsSplineSample> Samples;
+  float SampleInterval = 0.0f;
+  float InvSampleInterval = 0.0f;
+  float Length = 0.0f;
+};
+
+/**
+ * Piece of a long path with its own spline, sample table and bounds.
+ * Short paths have a single chunk that is the path's own spline.
+ */
+struct EPOCHRAILS_API FRailsSplineChunk {
+  USplineComponent *Spline = nullptr;
+  FRailsSplineSampleTable Table;
+
+  /** Index of the chunk's first point on the path's spline (shared with the previous chunk) */
+  int32 FirstPoint = 0;
+  int32 NumPoints = 0;
+
+  /** World bounds of the baked samples */
+  FBox Bounds = FBox(ForceInit);
+};
+
 /**
  * Spline path for trains to follow
- * Can be placed in level and edited visually
+ * Can be placed in level and edited visually.
+ *
+ * Paths with more than MaxPointsPerChunk points are split into transient
+ * sub-splines; distance queries find their chunk through a prefix sum of
+ * chunk lengths and SetPointLocation re-bakes only the chunks holding the
+ * point, so very long routes stay cheap to query and edit.
+ *
+ * Path distances are doubles; each chunk's spline and sample table work in
+ * short chunk-local float distances, which is all USplineComponent offers.
  */
 UCLASS(Blueprintable)
 class EPOCHRAILS_API ARailsSplinePath : public AActor {
@@ -17,6 +91,10 @@ class EPOCHRAILS_API ARailsSplinePath : public AActor {
 public:
   ARailsSplinePath();
 
+  virtual void PostInitializeComponents() override;
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 protected:
   /** The spline component defining the path */
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -34,24 +112,149 @@ protected:
   UPROPERTY(EditAnywhere, Category = "Debug")
   FLinearColor DebugColor = FLinearColor::Yellow;
 
+  /** Arc-length spacing of the baked sample table (smaller = more accurate, more memory) */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline|Sampling",
+            meta = (ClampMin = "1.0", UIMin = "5.0", UIMax = "200.0"))
+  float SampleInterval = 25.0f;
+
+  /** Paths with more points are split into chunks of this many (0 = never split) */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Spline|Sampling", meta = (ClampMin = "0"))
+  int32 MaxPointsPerChunk = 512;
+
 public:
-  /** Get the spline component */
+  /**
+   * Get the spline component. After SetPointLocation on a chunked path its
+   * tangents and reparam table are stale until RefreshAuthoringSpline.
+   */
   UFUNCTION(BlueprintPure, Category = "Spline")
   USplineComponent *GetSpline() const { return SplineComponent; }
 
   /** Get location at distance along spline */
   UFUNCTION(BlueprintPure, Category = "Spline")
-  FVector GetLocationAtDistance(float Distance) const;
+  FVector GetLocationAtDistance(double Distance) const;
 
   /** Get rotation at distance along spline */
   UFUNCTION(BlueprintPure, Category = "Spline")
-  FRotator GetRotationAtDistance(float Distance) const;
+  FRotator GetRotationAtDistance(double Distance) const;
+
+  /** Get unit direction of travel at distance along spline */
+  UFUNCTION(BlueprintPure, Category = "Spline")
+  FVector GetDirectionAtDistance(double Distance) const;
+
+  /** Get up vector at distance along spline */
+  UFUNCTION(BlueprintPure, Category = "Spline")
+  FVector GetUpVectorAtDistance(double Distance) const;
+
+  /** Get location and rotation at distance with a single table lookup */
+  UFUNCTION(BlueprintPure, Category = "Spline")
+  FTransform GetTransformAtDistance(double Distance) const;
 
   /** Get total spline length */
   UFUNCTION(BlueprintPure, Category = "Spline")
-  float GetSplineLength() const;
+  double GetSplineLength() const;
+
+  /**
+   * Project a world location onto the path, starting from a known distance.
+   * Only the part of the path within SearchRadius of the hint is examined;
+   * falls back to a full spline search when the answer jumps out of that window.
+   */
+  UFUNCTION(BlueprintPure, Category = "Spline|Projection")
+  double FindDistanceClosestToWorldLocationWarm(const FVector &WorldLocation, double HintDistance,
+                                                float SearchRadius = 500.0f) const;
+
+  /** Same as FindDistanceClosestToWorldLocationWarm, with input keys instead of distances */
+  UFUNCTION(BlueprintPure, Category = "Spline|Projection")
+  float FindInputKeyClosestToWorldLocationWarm(const FVector &WorldLocation, float HintInputKey,
+                                               float SearchRadius = 500.0f) const;
+
+  /** Full search over the whole spline (expensive on long paths) */
+  UFUNCTION(BlueprintPure, Category = "Spline|Projection")
+  double FindDistanceClosestToWorldLocation(const FVector &WorldLocation) const;
+
+  /** Closest point to a world location among distances MinDistance..MaxDistance only */
+  double FindDistanceClosestInRange(const FVector &WorldLocation, double MinDistance, double MaxDistance) const;
+
+  /** World bounds of the part of the path between two distances */
+  FBox GetBoundsInRange(double MinDistance, double MaxDistance) const;
+
+  /**
+   * Re-bake the distance lookup table (and reconnect the track network).
+   * Call this after editing spline points at runtime.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Spline")
+  void RebuildSampleTable();
+
+  /**
+   * Move one spline point. On a chunked path only the chunks sharing the
+   * point (or whose end tangents it shapes) are re-baked; the path's own
+   * spline is left un-reparameterised.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Spline")
+  void SetPointLocation(int32 PointIndex, const FVector &Location,
+                        ESplineCoordinateSpace::Type CoordinateSpace = ESplineCoordinateSpace::World);
+
+  /**
+   * Run the full UpdateSpline on the path's own spline if chunked point edits
+   * skipped it. Only needed before using GetSpline() directly.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Spline")
+  void RefreshAuthoringSpline();
+
+  // ===== Chunks =====
+
+  int32 GetNumChunks() const { return Chunks.Num(); }
+  const FRailsSplineChunk &GetChunk(int32 Index) const { return Chunks[Index]; }
+
+  /** Path distance at which a chunk begins */
+  double GetChunkStartDistance(int32 Index) const { return ChunkStarts[Index]; }
+  float GetChunkLength(int32 Index) const { return float(ChunkStarts[Index + 1] - ChunkStarts[Index]); }
+
+  /** Chunk containing a path distance (clamped), INDEX_NONE before the first bake */
+  int32 FindChunk(double Distance) const;
 
 #if WITH_EDITOR
   virtual void OnConstruction(const FTransform &Transform) override;
 #endif
+  virtual void Destroyed() override;
+  virtual void ApplyWorldOffset(const FVector &InOffset, bool bWorldShift) override;
+
+private:
+  /** Chunk and distance within it, nullptr before the first bake */
+  const FRailsSplineChunk *ResolveChunk(double Distance, float &OutLocalDistance) const;
+
+  /**
+   * Re-derive a pinned chunk end tangent from the full curve's neighbours of
+   * PointIndex. False if the point's tangents do not depend on its neighbours.
+   */
+  bool RefreshPinnedTangent(USplineComponent &ChunkSpline, int32 LocalIndex, int32 PointIndex) const;
+
+  /** Copy points First..Last of the path's spline into a chunk spline */
+  void CopyPointsToChunk(USplineComponent &ChunkSpline, int32 FirstPoint, int32 LastPoint) const;
+
+  static void BakeChunk(FRailsSplineChunk &Chunk, float Interval);
+
+  /** Recompute the chunk start distances after chunk lengths changed */
+  void RefreshChunkStarts();
+
+  /** Closest point on one chunk within its local distances Min..Max */
+  bool ProjectOntoChunk(const FRailsSplineChunk &Chunk, const FVector &WorldLocation, float MinDistance,
+                        float MaxDistance, float &OutDistance, float &OutDistanceSquared) const;
+
+  /** Let the track network and spatial index know chunks First..Last changed */
+  void NotifyTrackChanged(int32 FirstChunk, int32 LastChunk);
+
+  double GetDistanceAtInputKey(float InputKey) const;
+  float GetInputKeyAtDistance(double Distance) const;
+
+  TArray<FRailsSplineChunk> Chunks;
+
+  /** Prefix sum of chunk lengths, one more entry than Chunks */
+  TArray<double> ChunkStarts;
+
+  /** Sub-splines of a chunked path (empty when the path is a single chunk) */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<USplineComponent>> ChunkSplines;
+
+  /** Our spline's tangents and reparam table are stale (chunked edits only update the chunks) */
+  bool bAuthoringSplineDirty = false;
 };
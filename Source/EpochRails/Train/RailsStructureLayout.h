@@ -0,0 +1,34 @@
+// RailsStructureLayout.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsStructureLayout.generated.h"
+
+/** One structure of a layout, relative to the wagon origin */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsStructureLayoutEntry {
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+  TSubclassOf<AActor> StructureClass;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+  FTransform RelativeTransform;
+
+  /**
+   * Wagon-space bounds used to validate the layout before anything is spawned.
+   * Leave invalid to skip validation for this entry (bounds are then measured after spawning).
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+  FBox Footprint = FBox(ForceInit);
+};
+
+/** A group of structures placed onto a wagon in one batch (see ARailsWagon::PlaceLayout) */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsStructureLayout {
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout")
+  TArray<FRailsStructureLayoutEntry> Entries;
+};
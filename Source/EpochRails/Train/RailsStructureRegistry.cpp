@@ -0,0 +1,109 @@
+// RailsStructureRegistry.cpp
+
+#include "RailsStructureRegistry.h"
+
+#include "GameFramework/Actor.h"
+
+// ===== FRailsStructureTotals =====
+
+void FRailsStructureTotals::Add(UClass *Class, float InMass) {
+  ++Count;
+  Mass += InMass;
+  ++CountByClass.FindOrAdd(Class);
+}
+
+void FRailsStructureTotals::Remove(UClass *Class, float InMass) {
+  Count = FMath::Max(0, Count - 1);
+  Mass = Count > 0 ? Mass - InMass : 0.0f;
+
+  if (int32 *ClassCount = CountByClass.Find(Class)) {
+    if (--(*ClassCount) <= 0) {
+      CountByClass.Remove(Class);
+    }
+  }
+}
+
+void FRailsStructureTotals::Append(const FRailsStructureTotals &Other) {
+  Count += Other.Count;
+  Mass += Other.Mass;
+  for (const TPair<TSubclassOf<AActor>, int32> &Pair : Other.CountByClass) {
+    CountByClass.FindOrAdd(Pair.Key) += Pair.Value;
+  }
+}
+
+void FRailsStructureTotals::Subtract(const FRailsStructureTotals &Other) {
+  Count = FMath::Max(0, Count - Other.Count);
+  Mass = Count > 0 ? Mass - Other.Mass : 0.0f;
+  for (const TPair<TSubclassOf<AActor>, int32> &Pair : Other.CountByClass) {
+    if (int32 *ClassCount = CountByClass.Find(Pair.Key)) {
+      *ClassCount -= Pair.Value;
+      if (*ClassCount <= 0) {
+        CountByClass.Remove(Pair.Key);
+      }
+    }
+  }
+}
+
+void FRailsStructureTotals::Reset() {
+  Count = 0;
+  Mass = 0.0f;
+  CountByClass.Reset();
+}
+
+int32 FRailsStructureTotals::GetCountOfClass(TSubclassOf<AActor> Class) const {
+  const int32 *ClassCount = CountByClass.Find(Class);
+  return ClassCount ? *ClassCount : 0;
+}
+
+// ===== FRailsStructureRegistry =====
+
+bool FRailsStructureRegistry::Add(AActor *Structure, const FBox &Footprint, float Mass) {
+  if (!Structure || Indices.Contains(Structure)) {
+    return false;
+  }
+
+  FRailsStructureEntry &Entry = Entries.AddDefaulted_GetRef();
+  Entry.Actor = Structure;
+  Entry.Key = Structure;
+  Entry.Class = Structure->GetClass();
+  Entry.Footprint = Footprint;
+  Entry.Mass = Mass;
+
+  Indices.Add(Structure, Entries.Num() - 1);
+  Totals.Add(Entry.Class, Mass);
+  return true;
+}
+
+void FRailsStructureRegistry::RemoveAt(int32 Index) {
+  if (!Entries.IsValidIndex(Index)) {
+    return;
+  }
+
+  const FRailsStructureEntry &Removed = Entries[Index];
+  Totals.Remove(Removed.Class, Removed.Mass);
+  Indices.Remove(Removed.Key);
+
+  // Fill the hole with the last entry
+  const int32 LastIndex = Entries.Num() - 1;
+  if (Index != LastIndex) {
+    Entries[Index] = MoveTemp(Entries[LastIndex]);
+    Indices.Add(Entries[Index].Key, Index);
+  }
+  Entries.Pop(EAllowShrinking::No);
+}
+
+int32 FRailsStructureRegistry::IndexOf(const AActor *Structure) const {
+  const int32 *Index = Structure ? Indices.Find(Structure) : nullptr;
+  return Index ? *Index : INDEX_NONE;
+}
+
+void FRailsStructureRegistry::Reserve(int32 Number) {
+  Entries.Reserve(Number);
+  Indices.Reserve(Number);
+}
+
+void FRailsStructureRegistry::Reset() {
+  Entries.Reset();
+  Indices.Reset();
+  Totals.Reset();
+}
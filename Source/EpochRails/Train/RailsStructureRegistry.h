@@ -0,0 +1,78 @@
+// RailsStructureRegistry.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "RailsStructureRegistry.generated.h"
+
+/** Running totals over a set of placed structures */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsStructureTotals {
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "Structures")
+  int32 Count = 0;
+
+  /** Sum of the structures' physics body masses (kg) */
+  UPROPERTY(BlueprintReadOnly, Category = "Structures")
+  float Mass = 0.0f;
+
+  /** Number of structures per exact class */
+  UPROPERTY(BlueprintReadOnly, Category = "Structures")
+  TMap<TSubclassOf<AActor>, int32> CountByClass;
+
+  void Add(UClass *Class, float InMass);
+  void Remove(UClass *Class, float InMass);
+  void Append(const FRailsStructureTotals &Other);
+  void Subtract(const FRailsStructureTotals &Other);
+  void Reset();
+
+  int32 GetCountOfClass(TSubclassOf<AActor> Class) const;
+};
+
+/** One placed structure with the data cached when it was registered */
+struct FRailsStructureEntry {
+  TWeakObjectPtr<AActor> Actor;
+
+  /** Registry key, still valid after the actor is gone */
+  TObjectKey<AActor> Key;
+  UClass *Class = nullptr;
+
+  /** Bounds in the owner's local space */
+  FBox Footprint = FBox(ForceInit);
+  float Mass = 0.0f;
+};
+
+/**
+ * Dense array of placed structures plus an actor -> index map.
+ * Add, remove and lookup are O(1) (removal swaps the last entry into the hole)
+ * and totals are kept up to date on every change.
+ */
+struct EPOCHRAILS_API FRailsStructureRegistry {
+  /** Register a structure; returns false if it is already registered */
+  bool Add(AActor *Structure, const FBox &Footprint, float Mass);
+
+  /** Remove the entry at Index (order of the remaining entries is not preserved) */
+  void RemoveAt(int32 Index);
+
+  /** Index of a structure's entry, INDEX_NONE if not registered */
+  int32 IndexOf(const AActor *Structure) const;
+
+  bool Contains(const AActor *Structure) const { return IndexOf(Structure) != INDEX_NONE; }
+  int32 Num() const { return Entries.Num(); }
+
+  const TArray<FRailsStructureEntry> &GetEntries() const { return Entries; }
+  const FRailsStructureEntry &GetEntry(int32 Index) const { return Entries[Index]; }
+  void SetFootprint(int32 Index, const FBox &Footprint) { Entries[Index].Footprint = Footprint; }
+
+  const FRailsStructureTotals &GetTotals() const { return Totals; }
+
+  void Reserve(int32 Number);
+  void Reset();
+
+private:
+  TArray<FRailsStructureEntry> Entries;
+  TMap<TObjectKey<AActor>, int32> Indices;
+  FRailsStructureTotals Totals;
+};
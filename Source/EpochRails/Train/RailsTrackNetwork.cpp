@@ -0,0 +1,378 @@
+// RailsTrackNetwork.cpp
+
+#include "RailsTrackNetwork.h"
+
+#include "Algo/Reverse.h"
+
+#include "RailsSplinePath.h"
+
+// ===== Registration =====
+
+void URailsTrackNetwork::RegisterPath(ARailsSplinePath *Path) {
+  if (Path) {
+    RegisteredPaths.AddUnique(Path);
+    bGraphDirty = true;
+  }
+}
+
+void URailsTrackNetwork::UnregisterPath(ARailsSplinePath *Path) {
+  if (RegisteredPaths.Remove(Path) > 0) {
+    bGraphDirty = true;
+  }
+}
+
+// ===== Graph =====
+
+void URailsTrackNetwork::EnsureGraph() {
+  if (bGraphDirty) {
+    RebuildGraph();
+  }
+}
+
+void URailsTrackNetwork::RebuildGraph() {
+  bGraphDirty = false;
+  Paths.Reset();
+  PathIndices.Reset();
+  RouteCache.Reset();
+  SwitchStates.Reset();
+
+  RegisteredPaths.RemoveAll([](const TWeakObjectPtr<ARailsSplinePath> &Path) { return !Path.IsValid(); });
+  for (const TWeakObjectPtr<ARailsSplinePath> &WeakPath : RegisteredPaths) {
+    ARailsSplinePath *Path = WeakPath.Get();
+    const double Length = Path->GetSplineLength();
+    if (Length <= KINDA_SMALL_NUMBER) {
+      continue;
+    }
+
+    PathIndices.Add(Path, Paths.Num());
+    FPathNode &Node = Paths.AddDefaulted_GetRef();
+    Node.Path = Path;
+    Node.Length = Length;
+    Node.StartLocation = Path->GetLocationAtDistance(0.0f);
+    Node.EndLocation = Path->GetLocationAtDistance(Length);
+    Node.StartDirection = Path->GetDirectionAtDistance(0.0f);
+    Node.EndDirection = Path->GetDirectionAtDistance(Length);
+  }
+
+  // Hash every segment end so joining them is a neighbourhood lookup, not all pairs
+  // End id: PathIndex * 2 + (bAtEnd ? 1 : 0)
+  const float CellSize = FMath::Max(ConnectionTolerance, 1.0f);
+  auto GetEndLocation = [this](int32 End) {
+    const FPathNode &Node = Paths[End / 2];
+    return (End & 1) ? Node.EndLocation : Node.StartLocation;
+  };
+  auto GetCell = [CellSize](const FVector &Location) {
+    return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize),
+                      FMath::FloorToInt(Location.Z / CellSize));
+  };
+
+  TMap<FIntVector, TArray<int32>> EndCells;
+  EndCells.Reserve(Paths.Num() * 2);
+  for (int32 End = 0; End < Paths.Num() * 2; ++End) {
+    EndCells.FindOrAdd(GetCell(GetEndLocation(End))).Add(End);
+  }
+
+  // Arriving at a segment's end continues onto every segment leaving the same spot
+  // in about the same direction. A traversal exits through end id == its state id
+  // with the reverse bit flipped: forward leaves through the end, reverse through the start.
+  const int32 NumStates = Paths.Num() * 2;
+  const float MinAlignment = FMath::Cos(FMath::DegreesToRadians(MaxSwitchAngle));
+  const float ToleranceSquared = FMath::Square(ConnectionTolerance);
+
+  SuccessorOffsets.Reset(NumStates + 1);
+  Successors.Reset();
+  for (int32 State = 0; State < NumStates; ++State) {
+    SuccessorOffsets.Add(Successors.Num());
+
+    const int32 ExitEnd = MakeState(GetStatePath(State), !IsStateReverse(State));
+    const FVector ExitLocation = GetEndLocation(ExitEnd);
+    const FVector ExitDirection = GetExitDirection(State);
+    const FIntVector Cell = GetCell(ExitLocation);
+
+    for (int32 X = -1; X <= 1; ++X) {
+      for (int32 Y = -1; Y <= 1; ++Y) {
+        for (int32 Z = -1; Z <= 1; ++Z) {
+          const TArray<int32> *Ends = EndCells.Find(Cell + FIntVector(X, Y, Z));
+          if (!Ends) {
+            continue;
+          }
+          for (const int32 End : *Ends) {
+            if (End / 2 == GetStatePath(State) ||
+                FVector::DistSquared(GetEndLocation(End), ExitLocation) > ToleranceSquared) {
+              continue;
+            }
+
+            // Entering through a start drives forward, through an end drives in reverse
+            const int32 Next = MakeState(End / 2, (End & 1) != 0);
+            if (FVector::DotProduct(ExitDirection, GetEntryDirection(Next)) >= MinAlignment) {
+              Successors.Add(Next);
+            }
+          }
+        }
+      }
+    }
+  }
+  SuccessorOffsets.Add(Successors.Num());
+
+  // Carry switch settings over to the new state numbering
+  for (int32 i = SwitchSettings.Num() - 1; i >= 0; --i) {
+    const FSwitchSetting &Setting = SwitchSettings[i];
+    const int32 FromIndex = FindPathIndex(Setting.FromPath.Get());
+    const int32 ToIndex = FindPathIndex(Setting.ToPath.Get());
+    if (FromIndex == INDEX_NONE || ToIndex == INDEX_NONE) {
+      SwitchSettings.RemoveAtSwap(i);
+      continue;
+    }
+
+    const int32 From = MakeState(FromIndex, Setting.bFromReverse);
+    for (const int32 Next : GetSuccessors(From)) {
+      if (GetStatePath(Next) == ToIndex) {
+        SwitchStates.Add(From, Next);
+        break;
+      }
+    }
+  }
+
+  UE_LOG(LogTemp, Log, TEXT("Track network rebuilt: %d segments, %d connections"), Paths.Num(),
+         Successors.Num());
+}
+
+int32 URailsTrackNetwork::FindPathIndex(const ARailsSplinePath *Path) const {
+  const int32 *Index = Path ? PathIndices.Find(Path) : nullptr;
+  return Index ? *Index : INDEX_NONE;
+}
+
+FVector URailsTrackNetwork::GetExitLocation(int32 State) const {
+  const FPathNode &Node = Paths[GetStatePath(State)];
+  return IsStateReverse(State) ? Node.StartLocation : Node.EndLocation;
+}
+
+FVector URailsTrackNetwork::GetExitDirection(int32 State) const {
+  const FPathNode &Node = Paths[GetStatePath(State)];
+  return IsStateReverse(State) ? -Node.StartDirection : Node.EndDirection;
+}
+
+FVector URailsTrackNetwork::GetEntryDirection(int32 State) const {
+  const FPathNode &Node = Paths[GetStatePath(State)];
+  return IsStateReverse(State) ? -Node.EndDirection : Node.StartDirection;
+}
+
+TConstArrayView<int32> URailsTrackNetwork::GetSuccessors(int32 State) const {
+  return TConstArrayView<int32>(Successors.GetData() + SuccessorOffsets[State],
+                                SuccessorOffsets[State + 1] - SuccessorOffsets[State]);
+}
+
+TArray<ARailsSplinePath *> URailsTrackNetwork::GetConnectedPaths(ARailsSplinePath *Path) {
+  TArray<ARailsSplinePath *> Result;
+
+  EnsureGraph();
+  const int32 Index = FindPathIndex(Path);
+  if (Index == INDEX_NONE) {
+    return Result;
+  }
+
+  for (const bool bReverse : {false, true}) {
+    for (const int32 Next : GetSuccessors(MakeState(Index, bReverse))) {
+      if (ARailsSplinePath *NextPath = Paths[GetStatePath(Next)].Path.Get()) {
+        Result.AddUnique(NextPath);
+      }
+    }
+  }
+  return Result;
+}
+
+// ===== Switches =====
+
+bool URailsTrackNetwork::SetSwitch(ARailsSplinePath *FromPath, bool bFromReverse, ARailsSplinePath *ToPath) {
+  EnsureGraph();
+  const int32 FromIndex = FindPathIndex(FromPath);
+  const int32 ToIndex = FindPathIndex(ToPath);
+  if (FromIndex == INDEX_NONE || ToIndex == INDEX_NONE) {
+    return false;
+  }
+
+  const int32 From = MakeState(FromIndex, bFromReverse);
+  for (const int32 Next : GetSuccessors(From)) {
+    if (GetStatePath(Next) != ToIndex) {
+      continue;
+    }
+
+    SwitchStates.Add(From, Next);
+    SwitchSettings.RemoveAll([FromPath, bFromReverse](const FSwitchSetting &Setting) {
+      return Setting.FromPath == FromPath && Setting.bFromReverse == bFromReverse;
+    });
+    SwitchSettings.Add({FromPath, bFromReverse, ToPath});
+    return true;
+  }
+
+  UE_LOG(LogTemp, Warning, TEXT("URailsTrackNetwork::SetSwitch - %s does not continue onto %s"),
+         *FromPath->GetName(), *ToPath->GetName());
+  return false;
+}
+
+bool URailsTrackNetwork::GetContinuation(const ARailsSplinePath *FromPath, bool bFromReverse,
+                                         ARailsSplinePath *&OutPath, bool &bOutReverse) {
+  EnsureGraph();
+  const int32 FromIndex = FindPathIndex(FromPath);
+  if (FromIndex == INDEX_NONE) {
+    return false;
+  }
+
+  const int32 From = MakeState(FromIndex, bFromReverse);
+  int32 Next = INDEX_NONE;
+  if (const int32 *Switched = SwitchStates.Find(From)) {
+    Next = *Switched;
+  } else {
+    // No setting - take the straightest way through
+    const FVector ExitDirection = GetExitDirection(From);
+    float BestAlignment = -2.0f;
+    for (const int32 Candidate : GetSuccessors(From)) {
+      const float Alignment = FVector::DotProduct(ExitDirection, GetEntryDirection(Candidate));
+      if (Alignment > BestAlignment) {
+        BestAlignment = Alignment;
+        Next = Candidate;
+      }
+    }
+  }
+
+  if (Next == INDEX_NONE || !Paths[GetStatePath(Next)].Path.IsValid()) {
+    return false;
+  }
+  OutPath = Paths[GetStatePath(Next)].Path.Get();
+  bOutReverse = IsStateReverse(Next);
+  return true;
+}
+
+// ===== Routing =====
+
+bool URailsTrackNetwork::FindRoute(const FRailsTrackPosition &From, const FRailsTrackPosition &To,
+                                   TArray<FRailsTrackPosition> &OutLegs, FRailsTrackPosition &OutArrival) {
+  OutLegs.Reset();
+
+  // Further along the segment we are already on
+  if (From.Path == To.Path && (From.bReverse ? To.Distance <= From.Distance : To.Distance >= From.Distance)) {
+    OutArrival = To;
+    OutArrival.bReverse = From.bReverse;
+    return To.Path != nullptr;
+  }
+
+  EnsureGraph();
+  const int32 FromIndex = FindPathIndex(From.Path);
+  const int32 ToIndex = FindPathIndex(To.Path);
+  if (FromIndex == INDEX_NONE || ToIndex == INDEX_NONE) {
+    return false;
+  }
+
+  // Leg sequences do not depend on where on the origin/destination we are, so they cache
+  const int32 Origin = MakeState(FromIndex, From.bReverse);
+  const TPair<int32, int32> Key(Origin, ToIndex);
+  const FCachedRoute *Cached = RouteCache.Find(Key);
+  if (!Cached) {
+    if (RouteCache.Num() >= MaxCachedRoutes) {
+      RouteCache.Reset();
+    }
+    FCachedRoute &NewRoute = RouteCache.Add(Key);
+    SearchRoutes(Origin, ToIndex, NewRoute);
+    Cached = &NewRoute;
+  }
+
+  // Pick the arrival direction that is shorter to this particular point
+  const double ToLength = Paths[ToIndex].Length;
+  const double ToDistance = FMath::Clamp(To.Distance, 0.0, ToLength);
+  int32 Best = INDEX_NONE;
+  double BestCost = TNumericLimits<double>::Max();
+  for (int32 Direction = 0; Direction < 2; ++Direction) {
+    if (Cached->States[Direction].Num() == 0) {
+      continue;
+    }
+    const double Cost = Cached->Costs[Direction] - ToLength + (Direction ? ToLength - ToDistance : ToDistance);
+    if (Cost < BestCost) {
+      BestCost = Cost;
+      Best = Direction;
+    }
+  }
+  if (Best == INDEX_NONE) {
+    return false;
+  }
+
+  OutLegs.Reserve(Cached->States[Best].Num());
+  for (const int32 State : Cached->States[Best]) {
+    const FPathNode &Node = Paths[GetStatePath(State)];
+    FRailsTrackPosition &Leg = OutLegs.AddDefaulted_GetRef();
+    Leg.Path = Node.Path.Get();
+    Leg.bReverse = IsStateReverse(State);
+    Leg.Distance = Leg.bReverse ? Node.Length : 0.0;
+  }
+
+  OutArrival = To;
+  OutArrival.Distance = ToDistance;
+  OutArrival.bReverse = Best == 1;
+  return true;
+}
+
+void URailsTrackNetwork::SearchRoutes(int32 Origin, int32 DestinationPath, FCachedRoute &OutRoute) {
+  struct FOpenEntry {
+    double Estimate = 0.0;
+    double Cost = 0.0;
+    int32 State = INDEX_NONE;
+  };
+  auto ByEstimate = [](const FOpenEntry &A, const FOpenEntry &B) { return A.Estimate < B.Estimate; };
+
+  const int32 NumStates = Paths.Num() * 2;
+  Costs.Init(TNumericLimits<double>::Max(), NumStates);
+  Parents.Init(INDEX_NONE, NumStates);
+
+  // Straight-line distance to the nearer end of the destination never overestimates
+  const FVector DestinationStart = Paths[DestinationPath].StartLocation;
+  const FVector DestinationEnd = Paths[DestinationPath].EndLocation;
+  auto Heuristic = [&](int32 State) {
+    const FVector Exit = GetExitLocation(State);
+    return FMath::Min(FVector::Dist(Exit, DestinationStart), FVector::Dist(Exit, DestinationEnd));
+  };
+
+  // Cost of a state = length of every segment entered to reach it, its own included
+  TArray<FOpenEntry> Open;
+  for (const int32 Next : GetSuccessors(Origin)) {
+    const double Cost = Paths[GetStatePath(Next)].Length;
+    if (Cost < Costs[Next]) {
+      Costs[Next] = Cost;
+      Open.HeapPush({Cost + Heuristic(Next), Cost, Next}, ByEstimate);
+    }
+  }
+
+  const int32 Goals[2] = {MakeState(DestinationPath, false), MakeState(DestinationPath, true)};
+  while (Open.Num() > 0) {
+    FOpenEntry Entry;
+    Open.HeapPop(Entry, ByEstimate, EAllowShrinking::No);
+
+    // Nothing left can beat either arrival
+    if (Entry.Estimate >= FMath::Max(Costs[Goals[0]], Costs[Goals[1]])) {
+      break;
+    }
+    if (Entry.Cost > Costs[Entry.State] || GetStatePath(Entry.State) == DestinationPath) {
+      continue;
+    }
+
+    for (const int32 Next : GetSuccessors(Entry.State)) {
+      const double Cost = Entry.Cost + Paths[GetStatePath(Next)].Length;
+      if (Cost < Costs[Next]) {
+        Costs[Next] = Cost;
+        Parents[Next] = Entry.State;
+        Open.HeapPush({Cost + Heuristic(Next), Cost, Next}, ByEstimate);
+      }
+    }
+  }
+
+  for (int32 Direction = 0; Direction < 2; ++Direction) {
+    if (Costs[Goals[Direction]] == TNumericLimits<double>::Max()) {
+      continue;
+    }
+
+    TArray<int32> &States = OutRoute.States[Direction];
+    for (int32 State = Goals[Direction]; State != INDEX_NONE; State = Parents[State]) {
+      States.Add(State);
+    }
+    Algo::Reverse(States);
+    OutRoute.Costs[Direction] = Costs[Goals[Direction]];
+  }
+}
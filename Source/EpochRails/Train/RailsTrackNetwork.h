@@ -0,0 +1,143 @@
+// RailsTrackNetwork.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RailsTrackRoute.h"
+#include "RailsTrackNetwork.generated.h"
+
+class ARailsSplinePath;
+
+/**
+ * Graph of all track segments in the world.
+ * Segment ends closer than ConnectionTolerance form a node (a plain joint or
+ * a switch). A train may leave a segment onto any other segment at the same
+ * node that continues in roughly the same direction, driving it along or
+ * against its spline.
+ *
+ * Routing runs A* over directed segment traversals and caches the leg
+ * sequence per (origin traversal, destination segment), so repeated queries
+ * are a map lookup. The graph and cache are rebuilt lazily after a segment
+ * is added, removed or re-baked.
+ */
+UCLASS()
+class EPOCHRAILS_API URailsTrackNetwork : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ===== Registration =====
+
+  void RegisterPath(ARailsSplinePath *Path);
+  void UnregisterPath(ARailsSplinePath *Path);
+
+  /** A segment changed shape; reconnect before the next query */
+  void MarkDirty() { bGraphDirty = true; }
+
+  // ===== Switches =====
+
+  /**
+   * Set which segment a train coming off FromPath (in the given direction)
+   * continues onto. Returns false if ToPath does not connect there.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Track Network")
+  bool SetSwitch(ARailsSplinePath *FromPath, bool bFromReverse, ARailsSplinePath *ToPath);
+
+  /**
+   * Where a train leaving FromPath continues: the switch setting if there is
+   * one, otherwise the straightest connection. False at a dead end.
+   */
+  bool GetContinuation(const ARailsSplinePath *FromPath, bool bFromReverse, ARailsSplinePath *&OutPath,
+                       bool &bOutReverse);
+
+  // ===== Routing =====
+
+  /**
+   * Shortest way from From (travelling in From.bReverse direction) to To.
+   * OutLegs receives the segments after From's, ending with To's, and
+   * OutArrival the position on To with the direction it is reached in.
+   * Returns false if To cannot be reached.
+   */
+  bool FindRoute(const FRailsTrackPosition &From, const FRailsTrackPosition &To,
+                 TArray<FRailsTrackPosition> &OutLegs, FRailsTrackPosition &OutArrival);
+
+  /** Segments connected at either end of Path */
+  UFUNCTION(BlueprintPure, Category = "Track Network")
+  TArray<ARailsSplinePath *> GetConnectedPaths(ARailsSplinePath *Path);
+
+  int32 GetNumPaths() const { return Paths.Num(); }
+  int32 GetNumCachedRoutes() const { return RouteCache.Num(); }
+
+  /** Segment ends closer than this (cm) are joined */
+  float ConnectionTolerance = 50.0f;
+
+  /** Sharpest direction change (degrees) a train can take at a node */
+  float MaxSwitchAngle = 45.0f;
+
+  /** Cache is flushed when it grows past this many routes */
+  int32 MaxCachedRoutes = 4096;
+
+private:
+  /** Traversal state: PathIndex * 2 + (bReverse ? 1 : 0) */
+  static int32 MakeState(int32 PathIndex, bool bReverse) { return PathIndex * 2 + (bReverse ? 1 : 0); }
+  static int32 GetStatePath(int32 State) { return State / 2; }
+  static bool IsStateReverse(int32 State) { return (State & 1) != 0; }
+
+  struct FPathNode {
+    TWeakObjectPtr<ARailsSplinePath> Path;
+    double Length = 0.0;
+    FVector StartLocation = FVector::ZeroVector;
+    FVector EndLocation = FVector::ZeroVector;
+    /** Direction of travel leaving the start / arriving at the end */
+    FVector StartDirection = FVector::ForwardVector;
+    FVector EndDirection = FVector::ForwardVector;
+  };
+
+  /** Best known leg sequences from one traversal to both directions of one segment */
+  struct FCachedRoute {
+    TArray<int32> States[2];
+    double Costs[2] = {TNumericLimits<double>::Max(), TNumericLimits<double>::Max()};
+  };
+
+  void RebuildGraph();
+  void EnsureGraph();
+
+  int32 FindPathIndex(const ARailsSplinePath *Path) const;
+
+  /** Location and direction of travel where a traversal leaves its segment */
+  FVector GetExitLocation(int32 State) const;
+  FVector GetExitDirection(int32 State) const;
+  FVector GetEntryDirection(int32 State) const;
+
+  TConstArrayView<int32> GetSuccessors(int32 State) const;
+
+  /** A* from Origin to both traversals of DestinationPath */
+  void SearchRoutes(int32 Origin, int32 DestinationPath, FCachedRoute &OutRoute);
+
+  TArray<TWeakObjectPtr<ARailsSplinePath>> RegisteredPaths;
+  bool bGraphDirty = true;
+
+  TArray<FPathNode> Paths;
+  TMap<TObjectKey<ARailsSplinePath>, int32> PathIndices;
+
+  /** Successors of every traversal state, flattened */
+  TArray<int32> SuccessorOffsets;
+  TArray<int32> Successors;
+
+  /** Switch settings as set, re-resolved to states whenever the graph is rebuilt */
+  struct FSwitchSetting {
+    TWeakObjectPtr<ARailsSplinePath> FromPath;
+    bool bFromReverse = false;
+    TWeakObjectPtr<ARailsSplinePath> ToPath;
+  };
+  TArray<FSwitchSetting> SwitchSettings;
+
+  /** Traversal state -> successor state chosen by a switch */
+  TMap<int32, int32> SwitchStates;
+
+  TMap<TPair<int32, int32>, FCachedRoute> RouteCache;
+
+  /** A* scratch, reused between searches */
+  TArray<double> Costs;
+  TArray<int32> Parents;
+};
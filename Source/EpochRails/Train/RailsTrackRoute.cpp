@@ -0,0 +1,115 @@
+// RailsTrackRoute.cpp
+
+#include "RailsTrackRoute.h"
+
+#include "Algo/BinarySearch.h"
+
+#include "RailsSplinePath.h"
+
+void FRailsRoute::Reset(ARailsSplinePath *Path) {
+  Legs.Reset();
+  if (Path) {
+    FRailsRouteLeg &Leg = Legs.AddDefaulted_GetRef();
+    Leg.Path = Path;
+    Leg.Length = Path->GetSplineLength();
+  }
+}
+
+void FRailsRoute::Append(ARailsSplinePath *Path, bool bReverse) {
+  if (!Path) {
+    return;
+  }
+
+  const double StartDistance = GetEndDistance();
+  FRailsRouteLeg &Leg = Legs.AddDefaulted_GetRef();
+  Leg.Path = Path;
+  Leg.bReverse = bReverse;
+  Leg.StartDistance = StartDistance;
+  Leg.Length = Path->GetSplineLength();
+}
+
+void FRailsRoute::Prepend(ARailsSplinePath *Path, bool bReverse) {
+  if (!Path) {
+    return;
+  }
+
+  FRailsRouteLeg Leg;
+  Leg.Path = Path;
+  Leg.bReverse = bReverse;
+  Leg.Length = Path->GetSplineLength();
+  Leg.StartDistance = GetStartDistance() - Leg.Length;
+  Legs.Insert(Leg, 0);
+}
+
+void FRailsRoute::TrimBehind(double RouteDistance) {
+  int32 NumBehind = 0;
+  while (NumBehind < Legs.Num() - 1 && Legs[NumBehind].GetEndDistance() < RouteDistance) {
+    ++NumBehind;
+  }
+  if (NumBehind > 0) {
+    Legs.RemoveAt(0, NumBehind, EAllowShrinking::No);
+  }
+}
+
+void FRailsRoute::TrimAhead(double RouteDistance) {
+  int32 NumKept = Legs.Num();
+  while (NumKept > 1 && Legs[NumKept - 1].StartDistance > RouteDistance) {
+    --NumKept;
+  }
+  Legs.SetNum(NumKept, EAllowShrinking::No);
+}
+
+int32 FRailsRoute::FindLeg(double RouteDistance) const {
+  if (Legs.Num() == 0) {
+    return INDEX_NONE;
+  }
+
+  // Last leg starting at or before the distance
+  const int32 Index = Algo::UpperBoundBy(Legs, RouteDistance, &FRailsRouteLeg::StartDistance) - 1;
+  return FMath::Clamp(Index, 0, Legs.Num() - 1);
+}
+
+FRailsTrackPosition FRailsRoute::Resolve(double RouteDistance) const {
+  FRailsTrackPosition Position;
+
+  const int32 Index = FindLeg(RouteDistance);
+  if (Index == INDEX_NONE) {
+    return Position;
+  }
+
+  const FRailsRouteLeg &Leg = Legs[Index];
+  const double Along = FMath::Clamp(RouteDistance - Leg.StartDistance, 0.0, Leg.Length);
+  Position.Path = Leg.Path;
+  Position.bReverse = Leg.bReverse;
+  Position.Distance = Leg.bReverse ? Leg.Length - Along : Along;
+  return Position;
+}
+
+bool FRailsRoute::FindRouteDistance(const ARailsSplinePath *Path, double SplineDistance,
+                                    double &OutRouteDistance) const {
+  for (const FRailsRouteLeg &Leg : Legs) {
+    if (Leg.Path == Path) {
+      const double Along = FMath::Clamp(SplineDistance, 0.0, Leg.Length);
+      OutRouteDistance = Leg.StartDistance + (Leg.bReverse ? Leg.Length - Along : Along);
+      return true;
+    }
+  }
+  return false;
+}
+
+FTransform FRailsRoute::GetTransformAtDistance(double RouteDistance) const {
+  return GetTransformAt(Resolve(RouteDistance));
+}
+
+FTransform FRailsRoute::GetTransformAt(const FRailsTrackPosition &Position) {
+  if (!Position.Path) {
+    return FTransform::Identity;
+  }
+
+  FTransform Transform = Position.Path->GetTransformAtDistance(Position.Distance);
+  if (Position.bReverse) {
+    // Face back along the spline
+    Transform.SetRotation(Transform.GetRotation() * FQuat(FVector::UpVector, PI));
+  }
+  return Transform;
+}
@@ -0,0 +1,106 @@
+// RailsTrackRoute.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsTrackRoute.generated.h"
+
+class ARailsSplinePath;
+
+/** A point on the track network: one segment and the distance along its spline */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsTrackPosition {
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track")
+  TObjectPtr<ARailsSplinePath> Path = nullptr;
+
+  /** Distance along Path's spline (cm) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track")
+  double Distance = 0.0;
+
+  /** Travelling against the spline's direction */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Track")
+  bool bReverse = false;
+
+  bool IsValid() const { return Path != nullptr; }
+};
+
+/** One segment of a route, driven along or against its spline */
+USTRUCT()
+struct EPOCHRAILS_API FRailsRouteLeg {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TObjectPtr<ARailsSplinePath> Path = nullptr;
+
+  UPROPERTY()
+  bool bReverse = false;
+
+  /** Route distance at which this leg begins */
+  UPROPERTY()
+  double StartDistance = 0.0;
+
+  UPROPERTY()
+  double Length = 0.0;
+
+  double GetEndDistance() const { return StartDistance + Length; }
+};
+
+/**
+ * Chain of segments a train drives through, addressed by one continuous
+ * route distance. The train and its path history only ever deal in route
+ * distance; a leg lookup turns it into (segment, distance) when a pose is
+ * needed, so wagons follow the head through every switch it took.
+ *
+ * Legs are only ever added or trimmed at either end, never shifted, so route
+ * distances already recorded stay valid while the route grows (they may go
+ * negative when it grows backwards). Route distances keep
+ * growing over a long run, so they are doubles end to end: a float would
+ * already be down to centimetre steps after a few dozen kilometres.
+ */
+USTRUCT()
+struct EPOCHRAILS_API FRailsRoute {
+  GENERATED_BODY()
+
+  /** Start over with Path as the only leg, route distance == spline distance */
+  void Reset(ARailsSplinePath *Path);
+
+  void Clear() { Legs.Reset(); }
+
+  /** Continue the route onto another segment */
+  void Append(ARailsSplinePath *Path, bool bReverse);
+
+  /** Extend the route backwards with a segment leading into the first leg */
+  void Prepend(ARailsSplinePath *Path, bool bReverse);
+
+  /** Drop legs that end before RouteDistance (always keeps the last leg) */
+  void TrimBehind(double RouteDistance);
+
+  /** Drop legs that begin after RouteDistance (always keeps the first leg) */
+  void TrimAhead(double RouteDistance);
+
+  bool IsValid() const { return Legs.Num() > 0; }
+  double GetStartDistance() const { return Legs.Num() > 0 ? Legs[0].StartDistance : 0.0; }
+  double GetEndDistance() const { return Legs.Num() > 0 ? Legs.Last().GetEndDistance() : 0.0; }
+  const TArray<FRailsRouteLeg> &GetLegs() const { return Legs; }
+
+  /** Leg containing the route distance (clamped to the route) */
+  int32 FindLeg(double RouteDistance) const;
+
+  /** Segment, spline distance and direction at a route distance */
+  FRailsTrackPosition Resolve(double RouteDistance) const;
+
+  /** Route distance of a point on one of the legs; false if Path is not on the route */
+  bool FindRouteDistance(const ARailsSplinePath *Path, double SplineDistance, double &OutRouteDistance) const;
+
+  /** World pose facing the direction of travel */
+  FTransform GetTransformAtDistance(double RouteDistance) const;
+
+  /** World pose at a resolved position facing the direction of travel */
+  static FTransform GetTransformAt(const FRailsTrackPosition &Position);
+
+private:
+  UPROPERTY()
+  TArray<FRailsRouteLeg> Legs;
+};
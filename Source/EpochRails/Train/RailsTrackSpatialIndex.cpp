@@ -0,0 +1,239 @@
+// RailsTrackSpatialIndex.cpp
+
+#include "RailsTrackSpatialIndex.h"
+
+#include "RailsSplinePath.h"
+
+namespace {
+/** Chords between baked samples may bulge slightly past the samples themselves */
+constexpr float SegmentBoundsPadding = 50.0f;
+} // namespace
+
+// ===== Updates =====
+
+void URailsTrackSpatialIndex::UpdatePath(ARailsSplinePath *Path) {
+  if (!Path) {
+    return;
+  }
+  RemovePath(Path);
+
+  const int32 NumChunks = Path->GetNumChunks();
+  if (NumChunks == 0) {
+    return;
+  }
+
+  TArray<TArray<int32>> &ChunkSegments = PathSegments.Add(Path);
+  ChunkSegments.SetNum(NumChunks);
+  for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk) {
+    InsertChunk(Path, Chunk, ChunkSegments[Chunk]);
+  }
+  SegmentStamps.SetNumZeroed(Segments.Num());
+}
+
+void URailsTrackSpatialIndex::UpdatePathChunks(ARailsSplinePath *Path, int32 FirstChunk, int32 LastChunk) {
+  TArray<TArray<int32>> *ChunkSegments = Path ? PathSegments.Find(Path) : nullptr;
+  if (!ChunkSegments || ChunkSegments->Num() != Path->GetNumChunks()) {
+    // New path or re-chunked - nothing to reuse
+    UpdatePath(Path);
+    return;
+  }
+
+  // Segments hold chunk-local distances, so chunks outside the range stay valid
+  // even though their start distance moved
+  for (int32 Chunk = FMath::Max(FirstChunk, 0); Chunk <= FMath::Min(LastChunk, ChunkSegments->Num() - 1); ++Chunk) {
+    RemoveSegments((*ChunkSegments)[Chunk]);
+    InsertChunk(Path, Chunk, (*ChunkSegments)[Chunk]);
+  }
+  SegmentStamps.SetNumZeroed(Segments.Num());
+}
+
+void URailsTrackSpatialIndex::RemovePath(const ARailsSplinePath *Path) {
+  TArray<TArray<int32>> ChunkSegments;
+  if (!Path || !PathSegments.RemoveAndCopyValue(Path, ChunkSegments)) {
+    return;
+  }
+
+  for (TArray<int32> &Indices : ChunkSegments) {
+    RemoveSegments(Indices);
+  }
+}
+
+void URailsTrackSpatialIndex::InsertChunk(ARailsSplinePath *Path, int32 Chunk, TArray<int32> &OutIndices) {
+  const double ChunkStart = Path->GetChunkStartDistance(Chunk);
+  const float Length = Path->GetChunkLength(Chunk);
+  if (Length <= KINDA_SMALL_NUMBER) {
+    return;
+  }
+
+  const int32 NumPieces = FMath::Max(1, FMath::CeilToInt(Length / FMath::Max(SegmentLength, 1.0f)));
+  const float PieceLength = Length / NumPieces;
+
+  OutIndices.Reserve(NumPieces);
+  for (int32 Piece = 0; Piece < NumPieces; ++Piece) {
+    const int32 Index = FreeSegments.Num() > 0 ? FreeSegments.Pop(EAllowShrinking::No) : Segments.AddDefaulted();
+    FSegment &Segment = Segments[Index];
+    Segment.Path = Path;
+    Segment.Chunk = Chunk;
+    Segment.MinDistance = Piece * PieceLength;
+    Segment.MaxDistance = Piece == NumPieces - 1 ? Length : (Piece + 1) * PieceLength;
+    Segment.Bounds = Path->GetBoundsInRange(ChunkStart + Segment.MinDistance, ChunkStart + Segment.MaxDistance)
+                         .ExpandBy(SegmentBoundsPadding);
+    Segment.MinCell = GetCell(Segment.Bounds.Min);
+    Segment.MaxCell = GetCell(Segment.Bounds.Max);
+
+    for (int32 X = Segment.MinCell.X; X <= Segment.MaxCell.X; ++X) {
+      for (int32 Y = Segment.MinCell.Y; Y <= Segment.MaxCell.Y; ++Y) {
+        Cells.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+      }
+    }
+    OutIndices.Add(Index);
+  }
+}
+
+void URailsTrackSpatialIndex::RemoveSegments(TArray<int32> &Indices) {
+  for (const int32 Index : Indices) {
+    FSegment &Segment = Segments[Index];
+    for (int32 X = Segment.MinCell.X; X <= Segment.MaxCell.X; ++X) {
+      for (int32 Y = Segment.MinCell.Y; Y <= Segment.MaxCell.Y; ++Y) {
+        const FIntPoint Cell(X, Y);
+        if (TArray<int32> *CellSegments = Cells.Find(Cell)) {
+          CellSegments->RemoveSingleSwap(Index, EAllowShrinking::No);
+          if (CellSegments->Num() == 0) {
+            Cells.Remove(Cell);
+          }
+        }
+      }
+    }
+    Segment = FSegment();
+    FreeSegments.Add(Index);
+  }
+  Indices.Reset();
+}
+
+// ===== Queries =====
+
+bool URailsTrackSpatialIndex::FindNearestTrack(const FVector &WorldLocation, float MaxDistance,
+                                               FRailsTrackPosition &OutPosition, float &OutDistance) const {
+  bool bFound = false;
+  OutDistance = MaxDistance;
+
+  // Grow the search box until what we found is closer than anything outside it
+  float Reach = FMath::Min(CellSize, MaxDistance);
+  while (true) {
+    const FBox QueryBounds(WorldLocation - FVector(Reach), WorldLocation + FVector(Reach));
+    ForEachSegmentNear(QueryBounds, [&](int32 Index) {
+      const FSegment &Segment = Segments[Index];
+      if (Segment.Bounds.ComputeSquaredDistanceToPoint(WorldLocation) > FMath::Square(OutDistance)) {
+        return;
+      }
+
+      double PathDistance = 0.0;
+      const float Distance = ProjectOntoSegment(Segment, WorldLocation, PathDistance);
+      if (Distance <= OutDistance) {
+        OutDistance = Distance;
+        OutPosition.Path = Segment.Path.Get();
+        OutPosition.Distance = PathDistance;
+        OutPosition.bReverse = false;
+        bFound = true;
+      }
+    });
+
+    if ((bFound && OutDistance <= Reach) || Reach >= MaxDistance) {
+      break;
+    }
+    Reach = FMath::Min(Reach * 2.0f, MaxDistance);
+  }
+  return bFound;
+}
+
+TArray<FRailsTrackPosition> URailsTrackSpatialIndex::FindTracksInRadius(const FVector &WorldLocation,
+                                                                        float Radius) const {
+  // Best point per path
+  TMap<ARailsSplinePath *, TPair<float, double>> Closest;
+
+  const FBox QueryBounds(WorldLocation - FVector(Radius), WorldLocation + FVector(Radius));
+  ForEachSegmentNear(QueryBounds, [&](int32 Index) {
+    const FSegment &Segment = Segments[Index];
+    if (Segment.Bounds.ComputeSquaredDistanceToPoint(WorldLocation) > FMath::Square(Radius)) {
+      return;
+    }
+
+    double PathDistance = 0.0;
+    const float Distance = ProjectOntoSegment(Segment, WorldLocation, PathDistance);
+    if (Distance > Radius) {
+      return;
+    }
+
+    TPair<float, double> *Best = Closest.Find(Segment.Path.Get());
+    if (!Best) {
+      Closest.Add(Segment.Path.Get(), {Distance, PathDistance});
+    } else if (Distance < Best->Key) {
+      *Best = {Distance, PathDistance};
+    }
+  });
+
+  TArray<FRailsTrackPosition> Result;
+  Result.Reserve(Closest.Num());
+  for (const TPair<ARailsSplinePath *, TPair<float, double>> &Pair : Closest) {
+    FRailsTrackPosition &Position = Result.AddDefaulted_GetRef();
+    Position.Path = Pair.Key;
+    Position.Distance = Pair.Value.Value;
+  }
+  return Result;
+}
+
+FIntPoint URailsTrackSpatialIndex::GetCell(const FVector &Location) const {
+  // Clamped so unbounded queries do not overflow
+  constexpr double MaxCell = double(MAX_int32 / 4);
+  return FIntPoint(FMath::FloorToInt(FMath::Clamp(Location.X / CellSize, -MaxCell, MaxCell)),
+                   FMath::FloorToInt(FMath::Clamp(Location.Y / CellSize, -MaxCell, MaxCell)));
+}
+
+void URailsTrackSpatialIndex::ForEachSegmentNear(const FBox &QueryBounds, TFunctionRef<void(int32)> Func) const {
+  if (++QueryStamp == 0) {
+    // Wrapped - clear old stamps so nothing is skipped by accident
+    FMemory::Memzero(SegmentStamps.GetData(), SegmentStamps.Num() * sizeof(uint32));
+    QueryStamp = 1;
+  }
+
+  auto Visit = [this, &Func](int32 Index) {
+    if (SegmentStamps[Index] != QueryStamp && Segments[Index].Path.IsValid()) {
+      SegmentStamps[Index] = QueryStamp;
+      Func(Index);
+    }
+  };
+
+  // Huge queries: walking the occupied cells is cheaper than the empty ones
+  const FIntPoint MinCell = GetCell(QueryBounds.Min);
+  const FIntPoint MaxCell = GetCell(QueryBounds.Max);
+  const int64 NumQueryCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+  if (NumQueryCells > Cells.Num()) {
+    for (const TPair<FIntPoint, TArray<int32>> &Pair : Cells) {
+      if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y) {
+        for (const int32 Index : Pair.Value) {
+          Visit(Index);
+        }
+      }
+    }
+    return;
+  }
+
+  for (int32 X = MinCell.X; X <= MaxCell.X; ++X) {
+    for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y) {
+      if (const TArray<int32> *CellSegments = Cells.Find(FIntPoint(X, Y))) {
+        for (const int32 Index : *CellSegments) {
+          Visit(Index);
+        }
+      }
+    }
+  }
+}
+
+float URailsTrackSpatialIndex::ProjectOntoSegment(const FSegment &Segment, const FVector &WorldLocation,
+                                                  double &OutPathDistance) const {
+  const ARailsSplinePath *Path = Segment.Path.Get();
+  const double ChunkStart = Path->GetChunkStartDistance(Segment.Chunk);
+  OutPathDistance = Path->FindDistanceClosestInRange(WorldLocation, ChunkStart + Segment.MinDistance,
+                                                     ChunkStart + Segment.MaxDistance);
+  return FVector::Dist(Path->GetLocationAtDistance(OutPathDistance), WorldLocation);
+}
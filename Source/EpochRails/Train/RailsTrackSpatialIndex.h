@@ -0,0 +1,87 @@
+// RailsTrackSpatialIndex.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RailsTrackRoute.h"
+#include "RailsTrackSpatialIndex.generated.h"
+
+class ARailsSplinePath;
+
+/**
+ * Uniform 2D grid over the track in the world, for "which rail is near
+ * here" queries. Every path is cut into pieces of SegmentLength arc length;
+ * each piece's bounds go into the grid cells they cover, so a query only
+ * projects onto the few pieces around it instead of every spline.
+ *
+ * Paths add and refresh themselves whenever their sample table is re-baked,
+ * in the editor as well as at runtime; only the edited path - or, on a
+ * chunked path, only the edited chunks - is re-inserted.
+ */
+UCLASS()
+class EPOCHRAILS_API URailsTrackSpatialIndex : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Insert a path, or re-insert it after its shape changed */
+  void UpdatePath(ARailsSplinePath *Path);
+
+  /** Re-insert only chunks First..Last of a chunked path after they were re-baked */
+  void UpdatePathChunks(ARailsSplinePath *Path, int32 FirstChunk, int32 LastChunk);
+  void RemovePath(const ARailsSplinePath *Path);
+
+  /** Closest point on any track within MaxDistance. False if there is none. */
+  UFUNCTION(BlueprintCallable, Category = "Track")
+  bool FindNearestTrack(const FVector &WorldLocation, float MaxDistance, FRailsTrackPosition &OutPosition,
+                        float &OutDistance) const;
+
+  /** Closest point of every track passing within Radius (one result per path) */
+  UFUNCTION(BlueprintCallable, Category = "Track")
+  TArray<FRailsTrackPosition> FindTracksInRadius(const FVector &WorldLocation, float Radius) const;
+
+  int32 GetNumSegments() const { return Segments.Num() - FreeSegments.Num(); }
+
+  /** Grid cell edge (cm). Changing it only affects paths inserted afterwards. */
+  float CellSize = 2000.0f;
+
+  /** Arc length (cm) of the pieces paths are cut into */
+  float SegmentLength = 1000.0f;
+
+private:
+  struct FSegment {
+    TWeakObjectPtr<ARailsSplinePath> Path;
+    /** Distances are local to this chunk of the path */
+    int32 Chunk = 0;
+    float MinDistance = 0.0f;
+    float MaxDistance = 0.0f;
+    FBox Bounds = FBox(ForceInit);
+    FIntPoint MinCell = FIntPoint::ZeroValue;
+    FIntPoint MaxCell = FIntPoint::ZeroValue;
+  };
+
+  /** Cut one chunk of a path into segments and add them to the grid */
+  void InsertChunk(ARailsSplinePath *Path, int32 Chunk, TArray<int32> &OutIndices);
+  void RemoveSegments(TArray<int32> &Indices);
+
+  FIntPoint GetCell(const FVector &Location) const;
+
+  /** Visit every segment whose cells overlap the box once */
+  void ForEachSegmentNear(const FBox &QueryBounds, TFunctionRef<void(int32)> Func) const;
+
+  /** Project onto one segment; world distance and path distance of the closest point */
+  float ProjectOntoSegment(const FSegment &Segment, const FVector &WorldLocation, double &OutPathDistance) const;
+
+  TArray<FSegment> Segments;
+  TArray<int32> FreeSegments;
+
+  /** Cell -> segments overlapping it */
+  TMap<FIntPoint, TArray<int32>> Cells;
+
+  /** Path -> its segments per chunk, for incremental updates */
+  TMap<TObjectKey<ARailsSplinePath>, TArray<TArray<int32>>> PathSegments;
+
+  /** Query stamps so a segment in several cells is only tested once */
+  mutable TArray<uint32> SegmentStamps;
+  mutable uint32 QueryStamp = 0;
+};
@@ -6,18 +6,33 @@
 #include "Components/SceneComponent.h"
 #include "Components/SplineComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/LocalPlayer.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/GameStateBase.h"
 #include "EnhancedInputSubsystems.h"
 #include "GameFramework/FloatingPawnMovement.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "Net/UnrealNetwork.h"
 
 #include "Character/RailsPlayerCharacter.h"
+#include "RailsConsistTemplate.h"
 #include "RailsSplinePath.h"
+#include "RailsTrackNetwork.h"
+#include "RailsTrackSpatialIndex.h"
+#include "RailsTrainSubsystem.h"
 #include "RailsWagon.h"
+#include "RailsWagonPool.h"
 
 ARailsTrain::ARailsTrain() {
   PrimaryActorTick.bCanEverTick = true;
 
+  // Clients rebuild the whole consist from NetState instead of replicated transforms
+  bReplicates = true;
+  SetReplicatingMovement(false);
+  ConsistWagons.Owner = this;
+  ConsistStructures.Owner = this;
+
   Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
   SetRootComponent(Root);
 
@@ -46,11 +61,70 @@ ARailsTrain::ARailsTrain() {
 void ARailsTrain::BeginPlay() {
   Super::BeginPlay();
 
+  // Tick after the movement component so the cached distance reflects this frame's move
+  if (Movement) {
+    AddTickPrerequisiteComponent(Movement);
+  }
+
   if (InteriorTrigger) {
-    InteriorTrigger->OnComponentBeginOverlap.AddDynamic(
-        this, &ARailsTrain::OnInteriorBeginOverlap);
-    InteriorTrigger->OnComponentEndOverlap.AddDynamic(
-        this, &ARailsTrain::OnInteriorEndOverlap);
+    // Captured before kinematic movement turns the trigger absolute
+    const FVector Extent = InteriorTrigger->GetScaledBoxExtent();
+    PassengerVolume = FBox(-Extent, Extent).TransformBy(InteriorTrigger->GetRelativeTransform());
+
+    if (UsesAnalyticPassengerDetection()) {
+      InteriorTrigger->SetGenerateOverlapEvents(false);
+    } else {
+      InteriorTrigger->OnComponentBeginOverlap.AddDynamic(
+          this, &ARailsTrain::OnInteriorBeginOverlap);
+      InteriorTrigger->OnComponentEndOverlap.AddDynamic(
+          this, &ARailsTrain::OnInteriorEndOverlap);
+    }
+  }
+
+  if (bKinematicMovement && MovementMode == ERailsTrainMovementMode::SplineDistance) {
+    UPrimitiveComponent *const KinematicTriggers[] = {InteriorTrigger};
+    KinematicMotion.Initialize(*this, KinematicTriggers);
+  }
+
+  // Only the legacy steering mode still needs transform replication
+  if (HasAuthority()) {
+    SetReplicatingMovement(MovementMode == ERailsTrainMovementMode::ClosestPoint);
+  }
+
+  // Placed without a path - take the rail we were dropped on
+  if (!IsValid(ActivePath) && HasAuthority()) {
+    if (const URailsTrackSpatialIndex *TrackIndex = GetWorld()->GetSubsystem<URailsTrackSpatialIndex>()) {
+      FRailsTrackPosition Nearest;
+      float NearestDistance = 0.0f;
+      if (TrackIndex->FindNearestTrack(GetActorLocation(), TrackSnapRadius, Nearest, NearestDistance)) {
+        ActivePath = Nearest.Path;
+      }
+    }
+  }
+
+  // Route starts as just our path, route distance == spline distance
+  Route.Reset(ActivePath);
+
+  if (MovementMode == ERailsTrainMovementMode::SplineDistance && IsValid(ActivePath)) {
+    // One full search to find where we were placed, then distance is authoritative
+    CurrentSplineDistance = FindClosestSplineDistance();
+    ApplyPathTransform();
+  }
+
+  Consist.SetHistorySampleSpacing(PathHistorySampleSpacing);
+  Consist.ResetHistory(GetCurrentSplineDistance());
+
+  TrainSubsystem = GetWorld()->GetSubsystem<URailsTrainSubsystem>();
+  if (TrainSubsystem) {
+    TrainSubsystem->RegisterTrain(this);
+  }
+
+  if (bUseWagonPool) {
+    if (URailsWagonPool *Pool = GetWorld()->GetSubsystem<URailsWagonPool>()) {
+      for (const TPair<TSubclassOf<ARailsWagon>, int32> &WarmUp : WagonPoolWarmUp) {
+        Pool->WarmUp(WarmUp.Key, WarmUp.Value);
+      }
+    }
   }
 
   if (bAutoStart) {
@@ -58,26 +132,124 @@ void ARailsTrain::BeginPlay() {
   }
 }
 
+void ARailsTrain::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  for (const TSharedPtr<FStreamableHandle> &Handle : PendingTemplateLoads) {
+    if (Handle.IsValid()) {
+      Handle->CancelHandle();
+    }
+  }
+  PendingTemplateLoads.Reset();
+
+  Riders.Reset();
+
+  if (TrainSubsystem) {
+    TrainSubsystem->UnregisterTrain(this);
+    TrainSubsystem = nullptr;
+  }
+
+  Super::EndPlay(EndPlayReason);
+}
+
+void ARailsTrain::GetLifetimeReplicatedProps(TArray<FLifetimeProperty> &OutLifetimeProps) const {
+  Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+  DOREPLIFETIME(ARailsTrain, ActivePath);
+  DOREPLIFETIME(ARailsTrain, NetState);
+  DOREPLIFETIME(ARailsTrain, Route);
+  DOREPLIFETIME(ARailsTrain, ConsistWagons);
+  DOREPLIFETIME(ARailsTrain, ConsistStructures);
+}
+
+void ARailsTrain::ApplyWorldOffset(const FVector &InOffset, bool bWorldShift) {
+  Super::ApplyWorldOffset(InOffset, bWorldShift);
+
+  // Everything else is kept as route distance and does not care where the origin is
+  Riders.ApplyWorldOffset(InOffset);
+}
+
 void ARailsTrain::Tick(float DeltaTime) {
   Super::Tick(DeltaTime);
 
-  if (bStop) {
+  if (bConsistDescriptionDirty && !HasAuthority()) {
+    ApplyConsistDescription();
+  }
+
+  if (MovementMode == ERailsTrainMovementMode::SplineDistance && IsValid(ActivePath)) {
+    if (!Route.IsValid()) {
+      // Client before the route arrives
+      Route.Reset(ActivePath);
+    } else if (HasAuthority() && Route.Resolve(CurrentSplineDistance).Path != ActivePath) {
+      // ActivePath was changed from outside - start over on it where we stand
+      Route.Reset(ActivePath);
+      bHasDestination = false;
+      TeleportAlongRoute(FindClosestSplineDistance());
+    }
+  }
+
+  const bool bSimulated = !HasAuthority() && MovementMode == ERailsTrainMovementMode::SplineDistance;
+  if (bSimulated) {
+    ExtrapolateNetState(DeltaTime);
+  } else if (!bStop) {
+    if (MovementMode == ERailsTrainMovementMode::SplineDistance) {
+      AdvanceAlongPath(DeltaTime);
+    } else {
+      // Move forward using FloatingPawnMovement
+      AddMovementInput(GetActorForwardVector(), Speed);
+
+      // Update rotation to follow spline
+      UpdatePath();
+    }
+  }
+
+  if (HasAuthority() && MovementMode == ERailsTrainMovementMode::SplineDistance) {
+    UpdateNetState();
+  }
+
+  // Everyone reading the distance this frame shares this single computation
+  RefreshSplineDistanceCache();
+
+  // Wagons keep settling behind the locomotive even while it is stopped
+  UpdateConsist();
+}
+
+void ARailsTrain::RefreshSplineDistanceCache() {
+  CachedSplineDistanceFrame = MAX_uint64;
+  LastTickSplineDistance = GetCurrentSplineDistance();
+}
+
+void ARailsTrain::UpdateConsist() {
+  // Record history even without wagons so newly added ones have a path to follow
+  if (!Route.IsValid()) {
     return;
   }
 
-  // Move forward using FloatingPawnMovement
-  AddMovementInput(GetActorForwardVector(), Speed);
+  // Normally the subsystem evaluates all trains' wagons in parallel after every train has ticked
+  if (TrainSubsystem) {
+    Consist.RecordHead(GetCurrentSplineDistance(), &Route);
+    bConsistPosesPending = Consist.Num() > 0;
+    return;
+  }
 
-  // Update rotation to follow spline
-  UpdatePath();
+  Consist.Update(GetCurrentSplineDistance(), Route);
 }
 
 void ARailsTrain::StartTrain() {
   bStop = false;
+  bBrakingToStop = false;
+  Brake = 0.0f;
 }
 
 void ARailsTrain::StopTrain() {
+  const bool bDynamics = bSimulateDynamics && MovementMode == ERailsTrainMovementMode::SplineDistance;
+  if (bDynamics && !bStop && Dynamics.GetVelocity() != 0.0f) {
+    // Let the brakes bring it to a stand; AdvanceAlongPath stops the train then
+    bBrakingToStop = true;
+    return;
+  }
+
   bStop = true;
+  bBrakingToStop = false;
+  Dynamics.Reset();
 }
 
 USplineComponent *ARailsTrain::GetActiveSpline() const {
@@ -93,6 +265,9 @@ void ARailsTrain::UpdatePath() {
     return;
   }
 
+  // Closest-point steering reads the authoring spline itself; catch up on chunked edits (no-op otherwise)
+  ActivePath->RefreshAuthoringSpline();
+
   const FVector ActorLocation = GetActorLocation();
 
   // Check if reached end of spline
@@ -128,6 +303,505 @@ void ARailsTrain::UpdatePath() {
   SetActorRotation(NewRot);
 }
 
+void ARailsTrain::AdvanceAlongPath(float DeltaTime) {
+  if (!Route.IsValid()) {
+    return;
+  }
+
+  const float MaxSpeed = Movement ? Movement->GetMaxSpeed() : 0.0f;
+  const bool bDynamics = bSimulateDynamics && HasAuthority();
+
+  double Step = 0.0;
+  bool bAutoBraking = false;
+  if (bDynamics) {
+    Step = StepDynamics(DeltaTime, MaxSpeed, bAutoBraking);
+    CurrentPathAcceleration = Dynamics.GetAcceleration();
+  } else {
+    Step = Speed * MaxSpeed * DeltaTime;
+
+    // Know the track ahead (or behind the last wagon) before driving onto it
+    if (Step > 0.0) {
+      ExtendRoute(CurrentSplineDistance + Step + RouteLookAhead);
+    } else if (Step < 0.0) {
+      ExtendRouteBehind(CurrentSplineDistance + Step - Consist.GetLength() - RouteLookAhead);
+    }
+
+    // Constant speed between SetSpeed calls
+    CurrentPathAcceleration = 0.0f;
+  }
+
+  const double StopDistance = GetRouteStopDistance();
+  const double ReverseStopDistance = GetRouteReverseStopDistance();
+  CurrentSplineDistance = FMath::Clamp(CurrentSplineDistance + Step, ReverseStopDistance, StopDistance);
+
+  // Under dynamics the train moves the way it rolls; it has come to a stand
+  // short of the end when the automatic brakes held it against the throttle
+  const bool bStanding = bDynamics && Dynamics.GetVelocity() == 0.0f;
+  const bool bForward = bDynamics ? Step > 0.0 || (bStanding && bAutoBraking && Speed > 0.0f) : Speed > 0.0f;
+  const bool bBackward = bDynamics ? Step < 0.0 || (bStanding && bAutoBraking && Speed < 0.0f) : Speed < 0.0f;
+
+  // Stop at the destination or where the track ends
+  if (bForward && CurrentSplineDistance >= StopDistance - StopTolerance) {
+    bStop = true;
+    if (bHasDestination) {
+      UE_LOG(LogTemp, Log, TEXT("%s reached its destination"), *GetName());
+      ClearDestination();
+    }
+  } else if (bBackward && CurrentSplineDistance <= ReverseStopDistance + StopTolerance) {
+    bStop = true;
+  } else if (bStanding && bBrakingToStop) {
+    bStop = true;
+  }
+
+  if (bStop) {
+    bBrakingToStop = false;
+    Dynamics.Reset();
+    CurrentPathAcceleration = 0.0f;
+  }
+
+  UpdateActiveSegment();
+  ApplyPathTransform();
+}
+
+double ARailsTrain::StepDynamics(float DeltaTime, float MaxSpeed, bool &bOutAutoBraking) {
+  UpdateDynamicsVehicles();
+
+  const float Velocity = Dynamics.GetVelocity();
+  const float BrakingDeceleration = Dynamics.GetBrakingDeceleration(DynamicsSettings);
+  const double StoppingDistance = Velocity * Velocity / (2.0 * FMath::Max(BrakingDeceleration, 1.0f));
+
+  // Know the track for at least as far as it takes to stop, behind the last wagon when reversing
+  if (Velocity > 0.0f || Speed > 0.0f) {
+    ExtendRoute(CurrentSplineDistance + StoppingDistance + RouteLookAhead);
+  } else if (Velocity < 0.0f || Speed < 0.0f) {
+    ExtendRouteBehind(CurrentSplineDistance - StoppingDistance - Consist.GetLength() - RouteLookAhead);
+  }
+
+  // Braking to a stop shuts off traction, or the throttle would outpull the brakes
+  float Throttle = bBrakingToStop ? 0.0f : Speed;
+  float AppliedBrake = bBrakingToStop ? 1.0f : Brake;
+
+  // Brake for the destination or the end of the known track (half the tolerance to spare)
+  const float Direction = Velocity != 0.0f ? FMath::Sign(Velocity) : FMath::Sign(Speed);
+  const double Remaining = Direction >= 0.0f ? GetRouteStopDistance() - CurrentSplineDistance
+                                              : CurrentSplineDistance - GetRouteReverseStopDistance();
+  bOutAutoBraking = Direction != 0.0f && Remaining <= StoppingDistance + StopTolerance * 0.5f;
+  if (bOutAutoBraking) {
+    Throttle = 0.0f;
+    AppliedBrake = 1.0f;
+  }
+
+  return Dynamics.Advance(DeltaTime, DynamicsSettings, Throttle, AppliedBrake, MaxSpeed);
+}
+
+void ARailsTrain::UpdateDynamicsVehicles() {
+  const int32 NumVehicles = Consist.Num() + 1;
+  if (bDynamicsMassDirty || Dynamics.Num() != NumVehicles) {
+    Dynamics.SetNum(NumVehicles);
+    Dynamics.SetMass(0, LocomotiveMass);
+    for (int32 i = 0; i < Consist.Num(); ++i) {
+      Dynamics.SetMass(i + 1, Consist.GetWagon(i)->GetMass());
+    }
+    bDynamicsMassDirty = false;
+  }
+
+  // Every vehicle faces along the route, so forward.Z is the sine of the grade it stands on
+  Dynamics.SetGrade(0, GetActorForwardVector().Z);
+  for (int32 i = 0; i < Consist.Num(); ++i) {
+    Dynamics.SetGrade(i + 1, Consist.GetPose(i).GetRotation().GetForwardVector().Z);
+  }
+}
+
+void ARailsTrain::ExtendRoute(double UntilDistance) {
+  if (bHasDestination || !bFollowTrackNetwork) {
+    return;
+  }
+
+  URailsTrackNetwork *Network = GetWorld()->GetSubsystem<URailsTrackNetwork>();
+  if (!Network) {
+    return;
+  }
+
+  while (Route.IsValid() && Route.GetEndDistance() < UntilDistance) {
+    const FRailsRouteLeg &Last = Route.GetLegs().Last();
+    ARailsSplinePath *NextPath = nullptr;
+    bool bNextReverse = false;
+    if (!Network->GetContinuation(Last.Path, Last.bReverse, NextPath, bNextReverse)) {
+      break;
+    }
+    Route.Append(NextPath, bNextReverse);
+  }
+}
+
+void ARailsTrain::ExtendRouteBehind(double UntilDistance) {
+  if (!bFollowTrackNetwork) {
+    return;
+  }
+
+  URailsTrackNetwork *Network = GetWorld()->GetSubsystem<URailsTrackNetwork>();
+  if (!Network) {
+    return;
+  }
+
+  while (Route.IsValid() && Route.GetStartDistance() > UntilDistance) {
+    // Where a train leaving the first leg backwards would go, driven the other way round
+    const FRailsRouteLeg &First = Route.GetLegs()[0];
+    ARailsSplinePath *PrevPath = nullptr;
+    bool bPrevReverse = false;
+    if (!Network->GetContinuation(First.Path, !First.bReverse, PrevPath, bPrevReverse)) {
+      break;
+    }
+    Route.Prepend(PrevPath, !bPrevReverse);
+  }
+}
+
+void ARailsTrain::UpdateActiveSegment() {
+  // Keep every leg the last wagon may still be on
+  Route.TrimBehind(CurrentSplineDistance - Consist.GetLength() - RouteLookAhead);
+
+  ARailsSplinePath *HeadPath = Route.Resolve(CurrentSplineDistance).Path;
+  if (HeadPath && HeadPath != ActivePath) {
+    ActivePath = HeadPath;
+  }
+}
+
+double ARailsTrain::GetRouteStopDistance() const {
+  return bHasDestination ? FMath::Min(DestinationDistance, Route.GetEndDistance()) : Route.GetEndDistance();
+}
+
+double ARailsTrain::GetRouteReverseStopDistance() const {
+  return FMath::Min(Route.GetStartDistance() + Consist.GetLength(), CurrentSplineDistance);
+}
+
+FRailsTrackPosition ARailsTrain::GetTrackPosition() const {
+  return Route.Resolve(GetCurrentSplineDistance());
+}
+
+bool ARailsTrain::SetDestination(ARailsSplinePath *Path, double Distance) {
+  if (!HasAuthority() || !Path || !Route.IsValid()) {
+    return false;
+  }
+
+  URailsTrackNetwork *Network = GetWorld()->GetSubsystem<URailsTrackNetwork>();
+  FRailsTrackPosition Destination;
+  Destination.Path = Path;
+  Destination.Distance = Distance;
+
+  TArray<FRailsTrackPosition> Legs;
+  FRailsTrackPosition Arrival;
+  if (!Network || !Network->FindRoute(GetTrackPosition(), Destination, Legs, Arrival)) {
+    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::SetDestination - No route from %s to %s"), *GetNameSafe(ActivePath),
+           *Path->GetName());
+    return false;
+  }
+
+  // Replace whatever was planned ahead of the current segment
+  Route.TrimAhead(CurrentSplineDistance);
+  for (const FRailsTrackPosition &Leg : Legs) {
+    Route.Append(Leg.Path, Leg.bReverse);
+  }
+
+  const FRailsRouteLeg &Last = Route.GetLegs().Last();
+  DestinationDistance = Last.StartDistance + (Arrival.bReverse ? Last.Length - Arrival.Distance : Arrival.Distance);
+  bHasDestination = true;
+
+  UE_LOG(LogTemp, Log, TEXT("%s routed to %s over %d segments"), *GetName(), *Path->GetName(), Legs.Num());
+  return true;
+}
+
+void ARailsTrain::ClearDestination() {
+  bHasDestination = false;
+}
+
+void ARailsTrain::ApplyPathTransform() {
+  if (!IsValid(ActivePath) || !Movement) {
+    return;
+  }
+
+  const FTransform Target = Route.GetTransformAtDistance(CurrentSplineDistance);
+  if (KinematicMotion.IsInitialized()) {
+    KinematicMotion.Move(*this, Target, OverlapUpdateInterval);
+    return;
+  }
+
+  const FVector Delta = Target.GetLocation() - GetActorLocation();
+
+  FHitResult Hit;
+  Movement->SafeMoveUpdatedComponent(Delta, Target.GetRotation(), true, Hit);
+}
+
+void ARailsTrain::SetCurrentSplineDistance(double NewDistance) {
+  if (!IsValid(ActivePath)) {
+    return;
+  }
+
+  // Back to plain spline distances on ActivePath
+  Route.Reset(ActivePath);
+  bHasDestination = false;
+  TeleportAlongRoute(NewDistance);
+}
+
+void ARailsTrain::TeleportAlongRoute(double RouteDistance) {
+  if (!Route.IsValid()) {
+    return;
+  }
+
+  CurrentSplineDistance = FMath::Clamp(RouteDistance, Route.GetStartDistance(), Route.GetEndDistance());
+  if (MovementMode == ERailsTrainMovementMode::SplineDistance) {
+    ApplyPathTransform();
+  }
+
+  // Teleported - the recorded path behind us and the motion carried there no longer apply
+  Consist.ResetHistory(CurrentSplineDistance);
+  Dynamics.Reset();
+  bNetStateDirty = true;
+}
+
+float ARailsTrain::GetPathVelocity() const {
+  if (bStop || !Movement) {
+    return 0.0f;
+  }
+  if (!HasAuthority() && MovementMode == ERailsTrainMovementMode::SplineDistance) {
+    // Clients move by the replicated state, not by their copy of the throttle
+    return NetState.ExtrapolateVelocity(GetNetServerTime() - NetState.ServerTime);
+  }
+  if (bSimulateDynamics) {
+    return Dynamics.GetVelocity();
+  }
+  return Speed * Movement->GetMaxSpeed();
+}
+
+// ===== Replication =====
+
+double ARailsTrain::GetNetServerTime() const {
+  const UWorld *World = GetWorld();
+  if (const AGameStateBase *GameState = World ? World->GetGameState() : nullptr) {
+    return GameState->GetServerWorldTimeSeconds();
+  }
+  return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void ARailsTrain::UpdateNetState() {
+  const double Now = GetNetServerTime();
+  const float Velocity = GetPathVelocity();
+
+  // Clients extrapolate the last state; refresh once they would be off by more than the tolerance.
+  // The velocity error counts for how far it carries them before a correction eases out.
+  const double Age = Now - NetState.ServerTime;
+  const double PositionError = FMath::Abs(CurrentSplineDistance - NetState.Extrapolate(Age));
+  const double VelocityError = FMath::Abs(Velocity - NetState.ExtrapolateVelocity(Age));
+  const bool bMotionChanged =
+      bStop != NetState.bStopped || PositionError + VelocityError * NetSmoothingTime > NetErrorTolerance;
+  const bool bRefreshDue = !bStop && Now - NetState.ServerTime >= NetStateRefreshInterval;
+  if (!bNetStateDirty && !bMotionChanged && !bRefreshDue) {
+    return;
+  }
+
+  NetState.Distance = CurrentSplineDistance;
+  NetState.Velocity = Velocity;
+  NetState.Acceleration = CurrentPathAcceleration;
+  NetState.ServerTime = Now;
+  NetState.bStopped = bStop;
+  NetState.Quantize();
+  bNetStateDirty = false;
+}
+
+void ARailsTrain::ExtrapolateNetState(float DeltaTime) {
+  if (!bHasNetState || !Route.IsValid()) {
+    return;
+  }
+
+  // Ease the last correction out instead of popping
+  NetSmoothingOffset *= NetSmoothingTime > 0.0f ? FMath::Exp(-DeltaTime / NetSmoothingTime) : 0.0f;
+  if (FMath::Abs(NetSmoothingOffset) < 0.1f) {
+    NetSmoothingOffset = 0.0f;
+  }
+
+  const double Target = NetState.Extrapolate(GetNetServerTime() - NetState.ServerTime);
+  CurrentSplineDistance =
+      FMath::Clamp(Target + NetSmoothingOffset, Route.GetStartDistance(), Route.GetEndDistance());
+  ApplyPathTransform();
+}
+
+void ARailsTrain::OnRep_NetState() {
+  bStop = NetState.bStopped;
+  if (!Route.IsValid()) {
+    if (!IsValid(ActivePath)) {
+      return;
+    }
+    Route.Reset(ActivePath);
+  }
+
+  const double Target = NetState.Extrapolate(GetNetServerTime() - NetState.ServerTime);
+  const float Error = float(CurrentSplineDistance - Target);
+
+  if (!bHasNetState || FMath::Abs(Error) > NetSnapDistance) {
+    // First state or too far off - jump there and restart the wagons' history
+    bHasNetState = true;
+    NetSmoothingOffset = 0.0f;
+    TeleportAlongRoute(Target);
+    return;
+  }
+
+  // Keep showing where we are now and ease towards the new prediction
+  NetSmoothingOffset = Error;
+}
+
+void ARailsTrain::ApplyConsistDescription() {
+  // No path yet - wagons cannot be placed, try again next tick
+  if (!IsValid(ActivePath) || !Route.IsValid()) {
+    return;
+  }
+  bConsistDescriptionDirty = false;
+
+  // Structures the server no longer describes
+  TSet<uint32> DescribedStructures;
+  DescribedStructures.Reserve(ConsistStructures.Items.Num());
+  for (const FRailsConsistStructureItem &Item : ConsistStructures.Items) {
+    DescribedStructures.Add(Item.StructureId);
+  }
+  for (auto It = LocalStructures.CreateIterator(); It; ++It) {
+    if (!DescribedStructures.Contains(It.Key())) {
+      if (AActor *Structure = It.Value().Get()) {
+        Structure->Destroy();
+      }
+      It.RemoveCurrent();
+    }
+  }
+
+  TArray<const FRailsConsistWagonItem *> Described;
+  ConsistWagons.GetOrderedWagons(Described);
+
+  // Keep the matching front part of the consist
+  int32 NumMatching = 0;
+  while (NumMatching < AttachedWagons.Num() && NumMatching < Described.Num() && AttachedWagons[NumMatching] &&
+         AttachedWagons[NumMatching]->GetConsistNetId() == Described[NumMatching]->WagonId &&
+         AttachedWagons[NumMatching]->GetClass() == Described[NumMatching]->WagonClass) {
+    ++NumMatching;
+  }
+
+  // Re-ordered or removed wagons are rebuilt; their structures are placed again below
+  while (AttachedWagons.Num() > NumMatching) {
+    TArray<AActor *> WagonStructures;
+    if (ARailsWagon *LastWagon = AttachedWagons.Last()) {
+      WagonStructures = LastWagon->GetPlacedStructures();
+
+      // Replicated structures belong to the server; let go of them so a pooled wagon does not carry them off
+      TArray<AActor *> Children;
+      LastWagon->GetAttachedActors(Children);
+      for (AActor *Child : Children) {
+        if (Child->GetIsReplicated()) {
+          Child->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+        }
+      }
+    }
+    RemoveLastWagon();
+    for (AActor *Structure : WagonStructures) {
+      Structure->Destroy();
+    }
+  }
+
+  if (Described.Num() > NumMatching) {
+    TArray<TSubclassOf<ARailsWagon>> WagonClasses;
+    WagonClasses.Reserve(Described.Num() - NumMatching);
+    for (int32 i = NumMatching; i < Described.Num(); ++i) {
+      WagonClasses.Add(Described[i]->WagonClass);
+    }
+    AddWagons(WagonClasses);
+
+    for (int32 i = NumMatching; i < Described.Num() && i < AttachedWagons.Num(); ++i) {
+      if (AttachedWagons[i] && AttachedWagons[i]->GetClass() == Described[i]->WagonClass) {
+        AttachedWagons[i]->SetConsistNetId(Described[i]->WagonId);
+      }
+    }
+  }
+
+  // A failed spawn would fail again; wait for the next description change instead of respawning every tick
+  if (AttachedWagons.Num() != Described.Num()) {
+    UE_LOG(LogTemp, Warning, TEXT("%s: built %d of %d described wagons"), *GetName(), AttachedWagons.Num(),
+           Described.Num());
+  }
+
+  ApplyStructureDescription();
+}
+
+void ARailsTrain::ApplyStructureDescription() {
+  TMap<uint32, ARailsWagon *> WagonsById;
+  WagonsById.Reserve(AttachedWagons.Num());
+  for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
+    if (Wagon && Wagon->GetConsistNetId() != 0) {
+      WagonsById.Add(Wagon->GetConsistNetId(), Wagon);
+    }
+  }
+
+  // Group what is missing per wagon so each wagon places one batch
+  struct FPendingLayout {
+    FRailsStructureLayout Layout;
+    TArray<uint32> StructureIds;
+  };
+  TMap<ARailsWagon *, FPendingLayout> Pending;
+
+  for (const FRailsConsistStructureItem &Item : ConsistStructures.Items) {
+    ARailsWagon *const *Wagon = WagonsById.Find(Item.WagonId);
+    if (!Wagon) {
+      continue;
+    }
+
+    // The wagon does not replicate, so the client cannot resolve the server's attachment - attach it here.
+    // Items re-notify once the actor reference resolves, so a structure that has not arrived is picked up then.
+    if (Item.ReplicatedStructure) {
+      if (Item.ReplicatedStructure->GetAttachParentActor() != *Wagon) {
+        Item.ReplicatedStructure->AttachToActor(*Wagon, FAttachmentTransformRules::KeepRelativeTransform);
+        Item.ReplicatedStructure->SetActorRelativeTransform(FTransform(Item.RelativeRotation, Item.RelativeLocation));
+      }
+      continue;
+    }
+
+    const TWeakObjectPtr<AActor> *Existing = LocalStructures.Find(Item.StructureId);
+    if (!Item.StructureClass || (Existing && Existing->IsValid())) {
+      continue;
+    }
+
+    FPendingLayout &WagonPending = Pending.FindOrAdd(*Wagon);
+    FRailsStructureLayoutEntry &Entry = WagonPending.Layout.Entries.AddDefaulted_GetRef();
+    Entry.StructureClass = Item.StructureClass;
+    Entry.RelativeTransform = FTransform(Item.RelativeRotation, Item.RelativeLocation);
+    WagonPending.StructureIds.Add(Item.StructureId);
+  }
+
+  for (TPair<ARailsWagon *, FPendingLayout> &Pair : Pending) {
+    const TArray<AActor *> Spawned = Pair.Key->PlaceLayout(Pair.Value.Layout, false);
+
+    // Spawned keeps the layout order but skips failed spawns
+    int32 EntryIndex = 0;
+    for (AActor *Structure : Spawned) {
+      while (EntryIndex < Pair.Value.Layout.Entries.Num() &&
+             Pair.Value.Layout.Entries[EntryIndex].StructureClass != Structure->GetClass()) {
+        ++EntryIndex;
+      }
+      if (EntryIndex < Pair.Value.StructureIds.Num()) {
+        LocalStructures.Add(Pair.Value.StructureIds[EntryIndex++], Structure);
+      }
+    }
+  }
+}
+
+void ARailsTrain::OnConsistChanged() {
+  Consist.Rebuild(AttachedWagons);
+  bDynamicsMassDirty = true;
+
+  if (HasAuthority()) {
+    ConsistWagons.Sync(AttachedWagons);
+  }
+}
+
+double ARailsTrain::FindClosestSplineDistance() const {
+  if (!IsValid(ActivePath)) {
+    return 0.0;
+  }
+  return ActivePath->FindDistanceClosestToWorldLocation(GetActorLocation());
+}
+
 // ===== Passenger management =====
 
 bool ARailsTrain::IsPassengerInside(ARailsPlayerCharacter *Character) const {
@@ -151,6 +825,11 @@ void ARailsTrain::OnPlayerEnterTrain(ARailsPlayerCharacter *Character) {
   PassengersInside.Add(Character);
   SwitchInputMappingContext(Character, true);
 
+  if (bCarryPassengers) {
+    AActor *Vehicle = FindVehicleContaining(Character->GetActorLocation(), PassengerExitMargin);
+    Riders.Add(Character, Vehicle ? Vehicle : this);
+  }
+
   UE_LOG(LogTemp, Log, TEXT("Player %s entered train"), *Character->GetName());
 }
 
@@ -165,10 +844,80 @@ void ARailsTrain::OnPlayerExitTrain(ARailsPlayerCharacter *Character) {
       });
 
   SwitchInputMappingContext(Character, false);
+  Riders.Remove(Character);
 
   UE_LOG(LogTemp, Log, TEXT("Player %s exited train"), *Character->GetName());
 }
 
+void ARailsTrain::UpdatePassengerContainment(float DeltaTime,
+                                             TConstArrayView<TWeakObjectPtr<ARailsPlayerCharacter>> Candidates) {
+  PassengerCheckAccumulator += DeltaTime;
+  if (PassengerCheckAccumulator < PassengerCheckInterval) {
+    return;
+  }
+  PassengerCheckAccumulator = 0.0f;
+
+  // Passengers destroyed while inside
+  PassengersInside.RemoveAll(
+      [](const TWeakObjectPtr<ARailsPlayerCharacter> &WeakPassenger) { return !WeakPassenger.IsValid(); });
+
+  // Broad phase: world box around the whole consist
+  FBox ConsistBounds = PassengerVolume.TransformBy(GetActorTransform());
+  for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
+    if (Wagon) {
+      ConsistBounds += Wagon->GetPassengerVolume().TransformBy(Wagon->GetActorTransform());
+    }
+  }
+  if (!ConsistBounds.IsValid) {
+    return;
+  }
+  ConsistBounds = ConsistBounds.ExpandBy(PassengerExitMargin);
+
+  for (const TWeakObjectPtr<ARailsPlayerCharacter> &WeakCandidate : Candidates) {
+    ARailsPlayerCharacter *Candidate = WeakCandidate.Get();
+    if (!Candidate) {
+      continue;
+    }
+
+    // Hysteresis: getting on needs the plain volume, getting off needs to clear the margin
+    const bool bWasInside = IsPassengerInside(Candidate);
+    const FVector Location = Candidate->GetActorLocation();
+    AActor *Vehicle = ConsistBounds.IsInside(Location)
+                          ? FindVehicleContaining(Location, bWasInside ? PassengerExitMargin : 0.0f)
+                          : nullptr;
+
+    if (Vehicle && !bWasInside) {
+      OnPlayerEnterTrain(Candidate);
+    } else if (!Vehicle && bWasInside) {
+      OnPlayerExitTrain(Candidate);
+    } else if (Vehicle && bCarryPassengers) {
+      // Walked over to another wagon
+      Riders.SetVehicle(Candidate, Vehicle);
+    }
+  }
+}
+
+void ARailsTrain::CarryRiders(float DeltaTime) {
+  Riders.Carry(DeltaTime);
+}
+
+AActor *ARailsTrain::FindVehicleContaining(const FVector &WorldLocation, float Margin) const {
+  auto Contains = [&WorldLocation, Margin](const AActor &Vehicle, const FBox &Volume) {
+    return Volume.IsValid &&
+           Volume.ExpandBy(Margin).IsInside(Vehicle.GetActorTransform().InverseTransformPosition(WorldLocation));
+  };
+
+  if (Contains(*this, PassengerVolume)) {
+    return const_cast<ARailsTrain *>(this);
+  }
+  for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
+    if (Wagon && Contains(*Wagon, Wagon->GetPassengerVolume())) {
+      return Wagon;
+    }
+  }
+  return nullptr;
+}
+
 void ARailsTrain::SwitchInputMappingContext(ARailsPlayerCharacter *Character, bool bInsideTrain) {
   if (!Character) {
     return;
@@ -237,64 +986,165 @@ void ARailsTrain::OnInteriorEndOverlap(UPrimitiveComponent *OverlappedComponent,
 // ===== Wagon API =====
 
 ARailsWagon *ARailsTrain::AddWagon(TSubclassOf<ARailsWagon> WagonClass) {
-  // Use default class if none provided
-  TSubclassOf<ARailsWagon> ClassToSpawn = WagonClass ? WagonClass : DefaultWagonClass;
-  if (!ClassToSpawn) {
-    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::AddWagon - No wagon class specified and no default set"));
-    return nullptr;
-  }
+  const TArray<ARailsWagon *> Added = AddWagons({WagonClass});
+  return Added.Num() > 0 ? Added[0] : nullptr;
+}
 
-  USplineComponent *Spline = GetActiveSpline();
-  if (!Spline) {
-    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::AddWagon - No active spline path"));
-    return nullptr;
+TArray<ARailsWagon *> ARailsTrain::AddWagons(const TArray<TSubclassOf<ARailsWagon>> &WagonClasses) {
+  TArray<ARailsWagon *> Added;
+
+  if (!IsValid(ActivePath) || !Route.IsValid()) {
+    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::AddWagons - No active spline path"));
+    return Added;
   }
 
-  // Determine the leader for the new wagon
-  AActor *Leader = nullptr;
-  if (AttachedWagons.Num() > 0) {
-    Leader = AttachedWagons.Last();
-  } else {
-    Leader = this;
+  // Start from the back of the current consist
+  AActor *Leader = this;
+  double LeaderDistance = GetCurrentSplineDistance();
+  float LeaderRearOffset = RearCoupler ? FMath::Abs(RearCoupler->GetRelativeLocation().X) : 0.0f;
+  if (AttachedWagons.Num() > 0 && AttachedWagons.Last()) {
+    ARailsWagon *LastWagon = AttachedWagons.Last();
+    Leader = LastWagon;
+    LeaderDistance -= Consist.GetLength();
+    LeaderRearOffset = LastWagon->GetRearCouplerOffset();
   }
 
-  // Get spawn location from leader's rear coupler
-  FVector SpawnLocation;
-  FRotator SpawnRotation;
-  if (ARailsWagon *LastWagon = Cast<ARailsWagon>(Leader)) {
-    SpawnLocation = LastWagon->GetRearCoupler()->GetComponentLocation();
-    SpawnRotation = LastWagon->GetActorRotation();
-  } else {
-    SpawnLocation = RearCoupler->GetComponentLocation();
-    SpawnRotation = GetActorRotation();
+  URailsWagonPool *Pool = bUseWagonPool ? GetWorld()->GetSubsystem<URailsWagonPool>() : nullptr;
+  Added.Reserve(WagonClasses.Num());
+  AttachedWagons.Reserve(AttachedWagons.Num() + WagonClasses.Num());
+
+  for (const TSubclassOf<ARailsWagon> &WagonClass : WagonClasses) {
+    // Use default class if none provided
+    TSubclassOf<ARailsWagon> ClassToSpawn = WagonClass ? WagonClass : DefaultWagonClass;
+    if (!ClassToSpawn) {
+      UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::AddWagons - No wagon class specified and no default set"));
+      continue;
+    }
+
+    // Coupler layout from the class defaults - known before anything is spawned
+    const ARailsWagon *Defaults = ClassToSpawn->GetDefaultObject<ARailsWagon>();
+    const float FollowDistance = LeaderRearOffset + Defaults->GetFrontCouplerOffset() + Defaults->GetCouplingGap();
+
+    // Bring in the track behind so the wagon is not squeezed onto the start of the route
+    ExtendRouteBehind(LeaderDistance - FollowDistance);
+    const double Distance = FMath::Max(Route.GetStartDistance(), LeaderDistance - FollowDistance);
+    const FRailsTrackPosition Position = Route.Resolve(Distance);
+    const FTransform Pose = FRailsRoute::GetTransformAt(Position);
+
+    // Reuse a pooled wagon or spawn one directly at its final pose
+    ARailsWagon *NewWagon = Pool ? Pool->TryAcquirePooledWagon(ClassToSpawn, Pose, this) : nullptr;
+    if (NewWagon) {
+      NewWagon->InitializeInConsist(Leader, Position.Path, FollowDistance, Position.Distance, Pose);
+    } else {
+      NewWagon = GetWorld()->SpawnActorDeferred<ARailsWagon>(ClassToSpawn, Pose, this, nullptr,
+                                                            ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+      if (!NewWagon) {
+        UE_LOG(LogTemp, Error, TEXT("ARailsTrain::AddWagons - Failed to spawn wagon"));
+        continue;
+      }
+
+      // Leader, spline and distance are in place before BeginPlay runs
+      NewWagon->InitializeInConsist(Leader, Position.Path, FollowDistance, Position.Distance, Pose);
+      NewWagon->FinishSpawning(Pose);
+    }
+
+    // Update chain links
+    if (ARailsWagon *PrevWagon = Cast<ARailsWagon>(Leader)) {
+      PrevWagon->SetNextWagon(NewWagon);
+    }
+
+    // Add to our list and take over its movement
+    AttachedWagons.Add(NewWagon);
+    NewWagon->SetOwningTrain(this);
+    Added.Add(NewWagon);
+
+    Leader = NewWagon;
+    LeaderDistance = Distance;
+    LeaderRearOffset = Defaults->GetRearCouplerOffset();
   }
 
-  // Spawn the wagon
-  FActorSpawnParameters SpawnParams;
-  SpawnParams.Owner = this;
-  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+  if (Added.Num() > 0) {
+    OnConsistChanged();
+    UE_LOG(LogTemp, Log, TEXT("Added %d wagon(s) (total: %d)"), Added.Num(), AttachedWagons.Num());
+  }
+  return Added;
+}
 
-  ARailsWagon *NewWagon = GetWorld()->SpawnActor<ARailsWagon>(
-      ClassToSpawn, SpawnLocation, SpawnRotation, SpawnParams);
+bool ARailsTrain::AddWagonsFromTemplate(URailsConsistTemplate *Template) {
+  if (!Template || Template->Wagons.Num() == 0) {
+    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::AddWagonsFromTemplate - Empty or missing template"));
+    return false;
+  }
 
-  if (!NewWagon) {
-    UE_LOG(LogTemp, Error, TEXT("ARailsTrain::AddWagon - Failed to spawn wagon"));
-    return nullptr;
+  TArray<FSoftObjectPath> ClassPaths;
+  Template->GetClassesToLoad(ClassPaths);
+  if (ClassPaths.Num() == 0) {
+    // Only default wagons, nothing to stream
+    SpawnConsistTemplate(Template);
+    return true;
   }
 
-  // Attach to leader
-  NewWagon->AttachToLeader(Leader, Spline);
+  TWeakObjectPtr<URailsConsistTemplate> WeakTemplate = Template;
+  TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+      MoveTemp(ClassPaths), FStreamableDelegate::CreateWeakLambda(this, [this, WeakTemplate]() {
+        PendingTemplateLoads.RemoveAll([](const TSharedPtr<FStreamableHandle> &Pending) {
+          return !Pending.IsValid() || Pending->HasLoadCompleted();
+        });
+        if (URailsConsistTemplate *LoadedTemplate = WeakTemplate.Get()) {
+          SpawnConsistTemplate(LoadedTemplate);
+        }
+      }));
+
+  // Already-resident classes complete immediately
+  if (Handle.IsValid() && !Handle->HasLoadCompleted()) {
+    PendingTemplateLoads.Add(Handle);
+  }
+  return true;
+}
 
-  // Update chain links
-  if (ARailsWagon *PrevWagon = Cast<ARailsWagon>(Leader)) {
-    PrevWagon->SetNextWagon(NewWagon);
+void ARailsTrain::SpawnConsistTemplate(URailsConsistTemplate *Template) {
+  // Resolve classes up front so template entries stay paired with spawned wagons
+  TArray<TSubclassOf<ARailsWagon>> WagonClasses;
+  TArray<const FRailsTemplateWagon *> Entries;
+  WagonClasses.Reserve(Template->Wagons.Num());
+  Entries.Reserve(Template->Wagons.Num());
+  for (const FRailsTemplateWagon &Entry : Template->Wagons) {
+    TSubclassOf<ARailsWagon> WagonClass = Entry.WagonClass.Get();
+    if (!WagonClass && !Entry.WagonClass.IsNull()) {
+      UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::SpawnConsistTemplate - Failed to load %s"),
+             *Entry.WagonClass.ToString());
+      continue;
+    }
+    if (!WagonClass && !DefaultWagonClass) {
+      continue;
+    }
+    WagonClasses.Add(WagonClass);
+    Entries.Add(&Entry);
   }
 
-  // Add to our list
-  AttachedWagons.Add(NewWagon);
+  const TArray<ARailsWagon *> Added = AddWagons(WagonClasses);
+  if (Added.Num() != Entries.Num()) {
+    UE_LOG(LogTemp, Warning, TEXT("ARailsTrain::SpawnConsistTemplate - Spawned %d of %d wagons, skipping structures"),
+           Added.Num(), Entries.Num());
+  } else {
+    FRailsStructureLayout Layout;
+    for (int32 i = 0; i < Added.Num(); ++i) {
+      Layout.Entries.Reset();
+      for (const FRailsTemplateStructure &Structure : Entries[i]->Structures) {
+        if (UClass *StructureClass = Structure.StructureClass.Get()) {
+          FRailsStructureLayoutEntry &LayoutEntry = Layout.Entries.AddDefaulted_GetRef();
+          LayoutEntry.StructureClass = StructureClass;
+          LayoutEntry.RelativeTransform = Structure.RelativeTransform;
+        }
+      }
+      if (Layout.Entries.Num() > 0) {
+        Added[i]->PlaceLayout(Layout, false);
+      }
+    }
+  }
 
-  UE_LOG(LogTemp, Log, TEXT("Added wagon %s (total: %d)"), *NewWagon->GetName(), AttachedWagons.Num());
-  return NewWagon;
+  UE_LOG(LogTemp, Log, TEXT("Consist template %s spawned (%d wagons)"), *Template->GetName(), Added.Num());
+  OnConsistTemplateSpawned.Broadcast(Template, Added);
 }
 
 bool ARailsTrain::RemoveLastWagon() {
@@ -306,6 +1156,7 @@ bool ARailsTrain::RemoveLastWagon() {
   ARailsWagon *LastWagon = AttachedWagons.Last();
   if (!LastWagon) {
     AttachedWagons.Pop();
+    OnConsistChanged();
     return false;
   }
 
@@ -317,15 +1168,45 @@ bool ARailsTrain::RemoveLastWagon() {
     }
   }
 
-  // Detach and destroy
+  // Detach and return to the pool (or destroy)
   LastWagon->Detach();
   AttachedWagons.Pop();
-  LastWagon->Destroy();
+  OnConsistChanged();
+
+  URailsWagonPool *Pool = bUseWagonPool ? GetWorld()->GetSubsystem<URailsWagonPool>() : nullptr;
+  if (Pool) {
+    Pool->ReleaseWagon(LastWagon);
+  } else {
+    LastWagon->Destroy();
+  }
 
   UE_LOG(LogTemp, Log, TEXT("Removed last wagon (remaining: %d)"), AttachedWagons.Num());
   return true;
 }
 
+void ARailsTrain::OnWagonEndPlay(ARailsWagon *Wagon) {
+  const int32 Index = AttachedWagons.Find(Wagon);
+  if (Index == INDEX_NONE) {
+    return;
+  }
+
+  // Close the gap - the wagon behind couples onto whatever was in front of the removed one
+  AActor *Prev = this;
+  if (Index > 0) {
+    Prev = AttachedWagons[Index - 1];
+  }
+  ARailsWagon *Next = AttachedWagons.IsValidIndex(Index + 1) ? AttachedWagons[Index + 1].Get() : nullptr;
+  if (ARailsWagon *PrevWagon = Cast<ARailsWagon>(Prev)) {
+    PrevWagon->SetNextWagon(Next);
+  }
+  if (Next && Prev) {
+    Next->SetLeader(Prev);
+  }
+
+  AttachedWagons.RemoveAt(Index);
+  OnConsistChanged();
+}
+
 TArray<ARailsWagon *> ARailsTrain::GetAttachedWagons() const {
   TArray<ARailsWagon *> Result;
   for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
@@ -336,14 +1217,94 @@ TArray<ARailsWagon *> ARailsTrain::GetAttachedWagons() const {
   return Result;
 }
 
-float ARailsTrain::GetCurrentSplineDistance() const {
-  USplineComponent *Spline = GetActiveSpline();
-  if (!Spline) {
-    return 0.0f;
+int32 ARailsTrain::CopyWagonLayoutToAll(ARailsWagon *SourceWagon, bool bValidate) {
+  if (!SourceWagon) {
+    return 0;
+  }
+
+  const int32 NumSpawned = SourceWagon->CopyLayoutTo(GetAttachedWagons(), bValidate);
+  UE_LOG(LogTemp, Log, TEXT("Copied layout of %s to the train (%d structures)"), *SourceWagon->GetName(), NumSpawned);
+  return NumSpawned;
+}
+
+void ARailsTrain::ForEachStructure(TFunctionRef<void(ARailsWagon &, AActor &)> Func) const {
+  for (const TObjectPtr<ARailsWagon> &Wagon : AttachedWagons) {
+    if (Wagon) {
+      Wagon->ForEachStructure([&Func, &Wagon](AActor &Structure) { Func(*Wagon, Structure); });
+    }
+  }
+}
+
+void ARailsTrain::OnWagonJoined(ARailsWagon &Wagon) {
+  AddWagonStructureTotals(Wagon.GetStructureRegistry().GetTotals());
+
+  if (HasAuthority()) {
+    if (Wagon.GetConsistNetId() == 0) {
+      Wagon.SetConsistNetId(NextConsistNetId++);
+    }
+    Wagon.ForEachStructure([this, &Wagon](AActor &Structure) { OnWagonStructureTracked(Wagon, Structure); });
+  }
+}
+
+void ARailsTrain::OnWagonLeft(ARailsWagon &Wagon) {
+  RemoveWagonStructureTotals(Wagon.GetStructureRegistry().GetTotals());
+
+  if (HasAuthority()) {
+    for (const FRailsStructureEntry &Entry : Wagon.GetStructureRegistry().GetEntries()) {
+      OnWagonStructureUntracked(Wagon, Entry.Key);
+    }
+    Wagon.SetConsistNetId(0);
+  }
+}
+
+void ARailsTrain::OnWagonStructureTracked(const ARailsWagon &Wagon, AActor &Structure) {
+  if (!HasAuthority() || Wagon.GetConsistNetId() == 0) {
+    return;
+  }
+
+  const TObjectKey<AActor> Key(&Structure);
+  if (StructureNetIds.Contains(Key)) {
+    return;
+  }
+
+  const uint32 StructureId = NextConsistNetId++;
+  StructureNetIds.Add(Key, StructureId);
+  // Replicated structures (e.g. interactables) reach clients as actors of their own and only need attaching
+  ConsistStructures.AddStructure(StructureId, Wagon.GetConsistNetId(), Structure.GetClass(),
+                                 Structure.GetActorTransform().GetRelativeTransform(Wagon.GetActorTransform()),
+                                 Structure.GetIsReplicated() ? &Structure : nullptr);
+}
+
+void ARailsTrain::OnWagonStructureUntracked(const ARailsWagon &Wagon, TObjectKey<AActor> StructureKey) {
+  uint32 StructureId = 0;
+  if (StructureNetIds.RemoveAndCopyValue(StructureKey, StructureId)) {
+    ConsistStructures.RemoveStructure(StructureId);
+  }
+}
+
+double ARailsTrain::GetCurrentSplineDistance() const {
+  if (MovementMode == ERailsTrainMovementMode::SplineDistance) {
+    return CurrentSplineDistance;
+  }
+
+  if (CachedSplineDistanceFrame != GFrameCounter) {
+    CachedSplineDistance = ProjectSplineDistance();
+    CachedSplineDistanceFrame = GFrameCounter;
+  }
+  return CachedSplineDistance;
+}
+
+double ARailsTrain::ProjectSplineDistance() const {
+  if (!IsValid(ActivePath)) {
+    return 0.0;
   }
 
-  // Find the closest point on spline and get its distance
-  FVector CurrentLocation = GetActorLocation();
-  float InputKey = Spline->FindInputKeyClosestToWorldLocation(CurrentLocation);
-  return Spline->GetDistanceAlongSplineAtSplineInputKey(InputKey);
+  // The train only moves a little per frame - refine around the last answer
+  LastProjectedDistance =
+      bHasProjectionHint
+          ? ActivePath->FindDistanceClosestToWorldLocationWarm(GetActorLocation(), LastProjectedDistance,
+                                                               ProjectionSearchRadius)
+          : FindClosestSplineDistance();
+  bHasProjectionHint = true;
+  return LastProjectedDistance;
 }
@@ -4,6 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "RailsConsist.h"
+#include "RailsConsistDynamics.h"
+#include "RailsConsistReplication.h"
+#include "RailsKinematicMotion.h"
+#include "RailsRiders.h"
+#include "RailsStructureRegistry.h"
+#include "RailsTrackRoute.h"
+#include "RailsTrainNetState.h"
 #include "RailsTrain.generated.h"
 
 class UFloatingPawnMovement;
@@ -14,6 +22,30 @@ class UEnhancedInputLocalPlayerSubsystem;
 class ARailsSplinePath;
 class ARailsPlayerCharacter;
 class ARailsWagon;
+class URailsTrainSubsystem;
+class URailsConsistTemplate;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRailsConsistTemplateSpawned, URailsConsistTemplate *,
+                                             Template, const TArray<ARailsWagon *> &, Wagons);
+
+/** How the locomotive advances along its path */
+UENUM(BlueprintType)
+enum class ERailsTrainMovementMode : uint8 {
+  /** Train owns its spline distance and advances it by speed * dt */
+  SplineDistance UMETA(DisplayName = "Spline Distance"),
+  /** Legacy: FloatingPawnMovement input steered by closest-point searches */
+  ClosestPoint UMETA(DisplayName = "Closest Point (Legacy)")
+};
+
+/** How the train notices players getting on and off */
+UENUM(BlueprintType)
+enum class ERailsPassengerDetection : uint8 {
+  /** Registered players are tested against the train's and wagons' local volumes at a fixed rate */
+  Analytic UMETA(DisplayName = "Analytic"),
+  /** Legacy: begin/end overlap events of the interior trigger */
+  Overlap UMETA(DisplayName = "Overlap Trigger (Legacy)")
+};
 
 UCLASS(Blueprintable)
 class EPOCHRAILS_API ARailsTrain : public APawn {
@@ -23,24 +55,69 @@ public:
   ARailsTrain();
 
   virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
   virtual void Tick(float DeltaTime) override;
+  virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty> &OutLifetimeProps) const override;
+  virtual void ApplyWorldOffset(const FVector &InOffset, bool bWorldShift) override;
 
   // ===== Movement API =====
+
+  /** Release the brakes and let the throttle drive */
   UFUNCTION(BlueprintCallable, Category = "Train")
   void StartTrain();
 
+  /** Stop now, or with dynamics apply full brakes until the train stands */
   UFUNCTION(BlueprintCallable, Category = "Train")
   void StopTrain();
 
   UFUNCTION(BlueprintPure, Category = "Train")
   float GetSpeed() const { return Speed; }
 
+  /** Throttle -1..1 with dynamics (sign = direction), otherwise the fraction of MaxSpeed to travel at */
   UFUNCTION(BlueprintCallable, Category = "Train")
   void SetSpeed(float NewSpeed) { Speed = NewSpeed; }
 
+  /** Brake application 0..1 (dynamics only) */
+  UFUNCTION(BlueprintCallable, Category = "Train")
+  void SetBrake(float NewBrake) { Brake = FMath::Clamp(NewBrake, 0.0f, 1.0f); }
+
+  UFUNCTION(BlueprintPure, Category = "Train")
+  float GetBrake() const { return Brake; }
+
   UFUNCTION(BlueprintPure, Category = "Train")
   bool IsStopped() const { return bStop; }
 
+  /** Signed speed along the route (cm/s) */
+  UFUNCTION(BlueprintPure, Category = "Train")
+  float GetTrackVelocity() const { return GetPathVelocity(); }
+
+  /** Locomotive plus every wagon and its structures (kg), as last used by the dynamics */
+  UFUNCTION(BlueprintPure, Category = "Train|Dynamics")
+  float GetTrainMass() const { return Dynamics.GetTotalMass(); }
+
+  // ===== Route API =====
+
+  /**
+   * Route through the track network to a point on another segment and stop
+   * there (server only, driving forwards). Returns false if it cannot be reached.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Train|Route")
+  bool SetDestination(ARailsSplinePath *Path, double Distance);
+
+  /** Forget the destination; the train follows the switches again */
+  UFUNCTION(BlueprintCallable, Category = "Train|Route")
+  void ClearDestination();
+
+  UFUNCTION(BlueprintPure, Category = "Train|Route")
+  bool HasDestination() const { return bHasDestination; }
+
+  /** Segment the locomotive is on, distance along it and direction of travel */
+  UFUNCTION(BlueprintPure, Category = "Train|Route")
+  FRailsTrackPosition GetTrackPosition() const;
+
+  /** Segments behind and ahead of the train, addressed by route distance */
+  const FRailsRoute &GetRoute() const { return Route; }
+
   // ===== Passenger management =====
   UFUNCTION(BlueprintCallable, Category = "Train|Passengers")
   bool IsPassengerInside(ARailsPlayerCharacter *Character) const;
@@ -51,12 +128,49 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Train|Passengers")
   void OnPlayerExitTrain(ARailsPlayerCharacter *Character);
 
+  bool UsesAnalyticPassengerDetection() const { return PassengerDetection == ERailsPassengerDetection::Analytic; }
+
+  /**
+   * Test the candidates against the vehicle volumes (Analytic detection) and fire
+   * enter/exit on changes. Runs every PassengerCheckInterval; called by URailsTrainSubsystem.
+   */
+  void UpdatePassengerContainment(float DeltaTime, TConstArrayView<TWeakObjectPtr<ARailsPlayerCharacter>> Candidates);
+
+  /** Move riding passengers with their vehicles; called by URailsTrainSubsystem once all wagons are placed */
+  void CarryRiders(float DeltaTime);
+
+  /** The train or wagon whose passenger volume (grown by Margin) contains the location, or nullptr */
+  AActor *FindVehicleContaining(const FVector &WorldLocation, float Margin = 0.0f) const;
+
+  /** Interior volume in actor space (from the interior trigger's shape) */
+  const FBox &GetPassengerVolume() const { return PassengerVolume; }
+
   // ===== Wagon API =====
 
   /** Add a wagon to the train. Returns the created wagon or nullptr on failure. */
   UFUNCTION(BlueprintCallable, Category = "Train|Wagons")
   ARailsWagon *AddWagon(TSubclassOf<ARailsWagon> WagonClass = nullptr);
 
+  /**
+   * Add several wagons in one pass, front to back (nullptr entries use DefaultWagonClass).
+   * Layout comes from class defaults, wagons are spawned deferred straight onto
+   * their final pose and registered with the consist once.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Train|Wagons")
+  TArray<ARailsWagon *> AddWagons(const TArray<TSubclassOf<ARailsWagon>> &WagonClasses);
+
+  /**
+   * Stream in every class the template references, then append its wagons and
+   * structures. Returns false if there is nothing to build; completion is
+   * reported through OnConsistTemplateSpawned.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Train|Wagons")
+  bool AddWagonsFromTemplate(URailsConsistTemplate *Template);
+
+  /** Fired once a template requested with AddWagonsFromTemplate has been spawned */
+  UPROPERTY(BlueprintAssignable, Category = "Train|Wagons")
+  FOnRailsConsistTemplateSpawned OnConsistTemplateSpawned;
+
   /** Remove the last wagon from the train. Returns true if successful. */
   UFUNCTION(BlueprintCallable, Category = "Train|Wagons")
   bool RemoveLastWagon();
@@ -69,9 +183,86 @@ public:
   UFUNCTION(BlueprintPure, Category = "Train|Wagons")
   TArray<ARailsWagon *> GetAttachedWagons() const;
 
-  /** Get the current distance along the spline (needed by wagons) */
+  // ===== Structure totals (all attached wagons) =====
+
+  UFUNCTION(BlueprintPure, Category = "Train|Structures")
+  int32 GetStructureCount() const { return StructureTotals.Count; }
+
+  /** Total mass of the structures on all wagons (kg) */
+  UFUNCTION(BlueprintPure, Category = "Train|Structures")
+  float GetStructureMass() const { return StructureTotals.Mass; }
+
+  UFUNCTION(BlueprintPure, Category = "Train|Structures")
+  int32 GetStructureCountOfClass(TSubclassOf<AActor> StructureClass) const {
+    return StructureTotals.GetCountOfClass(StructureClass);
+  }
+
+  const FRailsStructureTotals &GetStructureTotals() const { return StructureTotals; }
+
+  /** Copy one wagon's structure layout onto every other wagon of the train. Returns structures spawned. */
+  UFUNCTION(BlueprintCallable, Category = "Train|Structures")
+  int32 CopyWagonLayoutToAll(ARailsWagon *SourceWagon, bool bValidate = true);
+
+  /** Visit every live structure on every attached wagon without allocating */
+  void ForEachStructure(TFunctionRef<void(ARailsWagon &, AActor &)> Func) const;
+
+  /** Kept up to date by the wagons */
+  void OnWagonStructureAdded(UClass *StructureClass, float Mass) {
+    StructureTotals.Add(StructureClass, Mass);
+    bDynamicsMassDirty = true;
+  }
+  void OnWagonStructureRemoved(UClass *StructureClass, float Mass) {
+    StructureTotals.Remove(StructureClass, Mass);
+    bDynamicsMassDirty = true;
+  }
+  void AddWagonStructureTotals(const FRailsStructureTotals &Totals) {
+    StructureTotals.Append(Totals);
+    bDynamicsMassDirty = true;
+  }
+  void RemoveWagonStructureTotals(const FRailsStructureTotals &Totals) {
+    StructureTotals.Subtract(Totals);
+    bDynamicsMassDirty = true;
+  }
+
+  /** A wagon started/stopped belonging to this train (totals and, on the server, replication ids) */
+  void OnWagonJoined(ARailsWagon &Wagon);
+  void OnWagonLeft(ARailsWagon &Wagon);
+
+  /** Server: describe a wagon's non-replicated structures to clients */
+  void OnWagonStructureTracked(const ARailsWagon &Wagon, AActor &Structure);
+  void OnWagonStructureUntracked(const ARailsWagon &Wagon, TObjectKey<AActor> StructureKey);
+
+  /** Client: ConsistWagons/ConsistStructures changed, rebuild the local consist next tick */
+  void OnConsistDescriptionReceived() { bConsistDescriptionDirty = true; }
+
+  /**
+   * Get the current route distance (needed by wagons). Equals the distance
+   * along ActivePath until the train crosses onto another segment.
+   * Computed at most once per frame; repeated calls return the cached value.
+   */
+  UFUNCTION(BlueprintPure, Category = "Train|Path")
+  double GetCurrentSplineDistance() const;
+
+  /** Distance along the spline as computed at the end of the train's last tick */
   UFUNCTION(BlueprintPure, Category = "Train|Path")
-  float GetCurrentSplineDistance() const;
+  double GetSplineDistanceAtLastTick() const { return LastTickSplineDistance; }
+
+  /** Teleport the train to a distance along the active path, dropping the route (SplineDistance mode) */
+  UFUNCTION(BlueprintCallable, Category = "Train|Path")
+  void SetCurrentSplineDistance(double NewDistance);
+
+  UFUNCTION(BlueprintPure, Category = "Train|Movement")
+  ERailsTrainMovementMode GetMovementMode() const { return MovementMode; }
+
+  /** Wagon state of this train, updated by URailsTrainSubsystem */
+  FRailsConsist &GetConsist() { return Consist; }
+
+  /** True when the head has moved this frame and the subsystem still has to place the wagons */
+  bool HasConsistPosesPending() const { return bConsistPosesPending; }
+  void ClearConsistPosesPending() { bConsistPosesPending = false; }
+
+  /** Called by a wagon that is destroyed while still part of this train */
+  void OnWagonEndPlay(ARailsWagon *Wagon);
 
   /** Get the rear coupler attachment point */
   UFUNCTION(BlueprintPure, Category = "Train|Wagons")
@@ -101,12 +292,20 @@ protected:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Wagons")
   TSubclassOf<ARailsWagon> DefaultWagonClass;
 
+  /** Wagons spawned into the world wagon pool at BeginPlay, per class */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Wagons")
+  TMap<TSubclassOf<ARailsWagon>, int32> WagonPoolWarmUp;
+
+  /** Take wagons from / return them to URailsWagonPool instead of spawning and destroying */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Wagons")
+  bool bUseWagonPool = true;
+
   /** All wagons attached to this train */
   UPROPERTY(BlueprintReadOnly, Category = "Train|Wagons")
   TArray<TObjectPtr<ARailsWagon>> AttachedWagons;
 
   // ===== Path settings =====
-  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path")
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Train|Path")
   TObjectPtr<ARailsSplinePath> ActivePath = nullptr;
 
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path")
@@ -115,7 +314,39 @@ protected:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path")
   float StopTolerance = 50.0f;
 
+  /**
+   * At the end of a segment continue onto the connected track (switch
+   * setting or straightest way) instead of stopping.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path")
+  bool bFollowTrackNetwork = true;
+
+  /** Without an ActivePath, start on the nearest track within this distance (cm) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path", meta = (ClampMin = "0.0"))
+  float TrackSnapRadius = 1000.0f;
+
+  /** How far (cm) the route is kept ahead of the locomotive and behind the last wagon */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path", meta = (ClampMin = "0.0"))
+  float RouteLookAhead = 2000.0f;
+
+  /** Spacing (cm of travel) of the locomotive path history that wagons follow */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Wagons", meta = (ClampMin = "1.0"))
+  float PathHistorySampleSpacing = 100.0f;
+
+  /** Search window (cm along the path) for warm-started projections */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Path")
+  float ProjectionSearchRadius = 500.0f;
+
   // ===== Movement settings =====
+
+  /** SplineDistance drives the train from its own distance, ClosestPoint is the legacy steering */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Movement")
+  ERailsTrainMovementMode MovementMode = ERailsTrainMovementMode::SplineDistance;
+
+  /**
+   * Speed input. With dynamics it is the throttle; without, the train travels
+   * Speed * Movement MaxSpeed cm/s (SplineDistance mode).
+   */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Movement")
   float Speed = 1.0f;
 
@@ -125,6 +356,79 @@ protected:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Movement")
   bool bAutoStart = false;
 
+  // ===== Dynamics settings =====
+
+  /**
+   * Drive the train with tractive effort, brakes and resistance instead of
+   * setting its speed (SplineDistance mode, server only). Movement MaxSpeed
+   * stays the speed limit.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Dynamics")
+  bool bSimulateDynamics = true;
+
+  /** Mass of the locomotive itself (kg) */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Dynamics", meta = (ClampMin = "0.0"))
+  float LocomotiveMass = 80000.0f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Dynamics")
+  FRailsDynamicsSettings DynamicsSettings;
+
+  /**
+   * Teleport along the rail instead of sweeping (SplineDistance mode only).
+   * The interior trigger then updates overlaps every OverlapUpdateInterval seconds.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Movement")
+  bool bKinematicMovement = true;
+
+  /** Seconds between trigger overlap updates while moving kinematically */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Movement",
+            meta = (ClampMin = "0.0", EditCondition = "bKinematicMovement"))
+  float OverlapUpdateInterval = 0.1f;
+
+  // ===== Network settings =====
+
+  /**
+   * Longest time between net state updates while the motion is steady;
+   * stopping, starting or drifting off the extrapolation is sent immediately.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Network", meta = (ClampMin = "0.05"))
+  float NetStateRefreshInterval = 1.0f;
+
+  /**
+   * Extrapolation error (cm) clients may build up before a refresh is sent:
+   * position error plus velocity error over NetSmoothingTime
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Network", meta = (ClampMin = "0.0"))
+  float NetErrorTolerance = 10.0f;
+
+  /** Time constant (s) over which clients ease out extrapolation errors */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Network", meta = (ClampMin = "0.0"))
+  float NetSmoothingTime = 0.25f;
+
+  /** Errors larger than this (cm) snap instead of easing */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Network", meta = (ClampMin = "0.0"))
+  float NetSnapDistance = 500.0f;
+
+  // ===== Passenger settings =====
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Passengers")
+  ERailsPassengerDetection PassengerDetection = ERailsPassengerDetection::Analytic;
+
+  /** Seconds between analytic containment checks */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Passengers", meta = (ClampMin = "0.0"))
+  float PassengerCheckInterval = 0.1f;
+
+  /**
+   * Passengers move with the vehicle they stand in (local-frame riding)
+   * instead of relying on character base tracking.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Passengers")
+  bool bCarryPassengers = true;
+
+  /** A passenger only counts as having left once this far (cm) outside every volume */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Train|Passengers", meta = (ClampMin = "0.0"))
+  float PassengerExitMargin = 30.0f;
+
   // ===== Input settings =====
   UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Train|Input")
   TObjectPtr<UInputMappingContext> DefaultInputMappingContext = nullptr;
@@ -141,6 +445,87 @@ protected:
 
   USplineComponent *GetActiveSpline() const;
 
+  /** Advance the authoritative distance by speed * dt (SplineDistance mode) */
+  void AdvanceAlongPath(float DeltaTime);
+
+  /** Server: append connected segments until the route reaches UntilDistance */
+  void ExtendRoute(double UntilDistance);
+
+  /** Server: prepend connected segments until the route starts at or before UntilDistance */
+  void ExtendRouteBehind(double UntilDistance);
+
+  /** Drop legs nobody stands on any more and point ActivePath at the head's segment */
+  void UpdateActiveSegment();
+
+  /** Route distance the train must stop at (destination or end of the known track) */
+  double GetRouteStopDistance() const;
+
+  /**
+   * Lowest route distance the head may reverse to: where the last wagon
+   * reaches the start of the known track (or where it is now, if it already
+   * hangs past it)
+   */
+  double GetRouteReverseStopDistance() const;
+
+  /** Move to a route distance and restart the wagons' history */
+  void TeleportAlongRoute(double RouteDistance);
+
+  /** Signed speed along the path (cm/s) */
+  float GetPathVelocity() const;
+
+  /**
+   * Distance along the route the train advances this frame under the dynamics
+   * model. bOutAutoBraking is set while it brakes for the end of the route.
+   */
+  double StepDynamics(float DeltaTime, float MaxSpeed, bool &bOutAutoBraking);
+
+  /** Refresh vehicle masses (when changed) and the grade under every vehicle */
+  void UpdateDynamicsVehicles();
+
+  // ===== Replication =====
+
+  /** Server: refresh NetState when the motion changes or NetStateRefreshInterval has passed */
+  void UpdateNetState();
+
+  /** Client: place the train from the extrapolated NetState, easing out corrections */
+  void ExtrapolateNetState(float DeltaTime);
+
+  /** Server world time, synchronised on clients through the game state */
+  double GetNetServerTime() const;
+
+  UFUNCTION()
+  void OnRep_NetState();
+
+  /** Client: spawn/remove local wagons and structures until they match the replicated description */
+  void ApplyConsistDescription();
+
+  /**
+   * Client: spawn the described structures that are not on their wagon yet
+   * and attach the replicated ones that have arrived
+   */
+  void ApplyStructureDescription();
+
+  /** AttachedWagons changed - rebuild the consist and publish the wagon order */
+  void OnConsistChanged();
+
+  /** Place the train at CurrentSplineDistance on the active path */
+  void ApplyPathTransform();
+
+  /** Record the locomotive's distance and place all wagons behind it */
+  void UpdateConsist();
+
+  /** Full closest-point search for the actor's current location */
+  double FindClosestSplineDistance() const;
+
+  /** Project the actor onto the path, warm-started from the last answer (ClosestPoint mode) */
+  double ProjectSplineDistance() const;
+
+  /** Recompute the per-frame distance cache now that the train has moved */
+  void RefreshSplineDistanceCache();
+
+  /** Spawn a template whose classes are already loaded */
+  void SpawnConsistTemplate(URailsConsistTemplate *Template);
+
   // ===== Passenger helpers =====
   void SwitchInputMappingContext(ARailsPlayerCharacter *Character, bool bInsideTrain);
   UEnhancedInputLocalPlayerSubsystem *GetInputSubsystem(ARailsPlayerCharacter *Character) const;
@@ -158,6 +543,100 @@ protected:
                             UPrimitiveComponent *OtherComp,
                             int32 OtherBodyIndex);
 
+  /** Motion sample replicated to clients (SplineDistance mode) */
+  UPROPERTY(ReplicatedUsing = OnRep_NetState)
+  FRailsTrainNetState NetState;
+
+  /** Wagon order; clients build their own wagons from it */
+  UPROPERTY(Replicated)
+  FRailsConsistWagonArray ConsistWagons;
+
+  /** Structures on the wagons; clients spawn local copies or attach the replicated actors */
+  UPROPERTY(Replicated)
+  FRailsConsistStructureArray ConsistStructures;
+
+  /** Authoritative route distance (SplineDistance mode) */
+  UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Train|Path")
+  double CurrentSplineDistance = 0.0;
+
+  /** Segments the consist occupies and the track ahead; distances above are along it */
+  UPROPERTY(Replicated)
+  FRailsRoute Route;
+
 private:
   TArray<TWeakObjectPtr<ARailsPlayerCharacter>> PassengersInside;
+
+  /** Interior volume in actor space, captured at BeginPlay */
+  FBox PassengerVolume = FBox(ForceInit);
+
+  float PassengerCheckAccumulator = 0.0f;
+
+  /** Acceleration along the path during the last advance (cm/s^2) */
+  float CurrentPathAcceleration = 0.0f;
+
+  /** Longitudinal motion of the whole consist (bSimulateDynamics) */
+  FRailsConsistDynamics Dynamics;
+
+  /** Brake application set through SetBrake */
+  float Brake = 0.0f;
+
+  /** StopTrain was called while moving - brake until standing, then stop */
+  bool bBrakingToStop = false;
+
+  /** Vehicle masses have to be re-read before the next dynamics step */
+  bool bDynamicsMassDirty = true;
+
+  /** Client: remaining correction being eased out (cm) */
+  float NetSmoothingOffset = 0.0f;
+  bool bHasNetState = false;
+
+  /** Server: next UpdateNetState must send (teleport) */
+  bool bNetStateDirty = true;
+
+  /** Route distance to stop at (SetDestination) */
+  double DestinationDistance = 0.0;
+  bool bHasDestination = false;
+
+  /** Client: description changed since the last ApplyConsistDescription */
+  bool bConsistDescriptionDirty = false;
+
+  /** Server: ids handed to wagons and structures, 0 means none */
+  uint32 NextConsistNetId = 1;
+  TMap<TObjectKey<AActor>, uint32> StructureNetIds;
+
+  /** Client: local structure built for each described one */
+  TMap<uint32, TWeakObjectPtr<AActor>> LocalStructures;
+
+  /** Passengers carried in their vehicle's frame (bCarryPassengers) */
+  FRailsRiders Riders;
+
+  /** Structure totals over all attached wagons, maintained incrementally */
+  FRailsStructureTotals StructureTotals;
+
+  /** Flat wagon state, rebuilt whenever AttachedWagons changes */
+  FRailsConsist Consist;
+
+  /** Head recorded this frame, wagon poses not yet evaluated */
+  bool bConsistPosesPending = false;
+
+  /** Template class loads still in flight, cancelled on EndPlay */
+  TArray<TSharedPtr<FStreamableHandle>> PendingTemplateLoads;
+
+  /** Sweep-free mover used when bKinematicMovement is set */
+  FRailsKinematicMotion KinematicMotion;
+
+  /** Subsystem that evaluates our wagon poses (cached at BeginPlay) */
+  UPROPERTY(Transient)
+  TObjectPtr<URailsTrainSubsystem> TrainSubsystem = nullptr;
+
+  /** Last projected distance, used as the hint for the next projection (ClosestPoint mode) */
+  mutable double LastProjectedDistance = 0.0;
+  mutable bool bHasProjectionHint = false;
+
+  /** Per-frame memo of GetCurrentSplineDistance(), stamped with GFrameCounter */
+  mutable double CachedSplineDistance = 0.0;
+  mutable uint64 CachedSplineDistanceFrame = MAX_uint64;
+
+  /** Distance stored at the end of the last tick */
+  double LastTickSplineDistance = 0.0;
 };
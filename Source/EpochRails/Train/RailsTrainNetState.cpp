@@ -0,0 +1,82 @@
+// RailsTrainNetState.cpp
+
+#include "RailsTrainNetState.h"
+
+namespace {
+constexpr double DistanceScale = 8.0;
+constexpr float VelocityScale = 1.0f;
+constexpr float AccelerationScale = 16.0f;
+
+constexpr int32 DistanceBits = 40;
+constexpr uint64 MaxQuantizedDistance = (uint64(1) << DistanceBits) - 1;
+
+uint64 QuantizeDistance(double Distance) {
+  return static_cast<uint64>(
+      FMath::Clamp<int64>(FMath::RoundToInt64(Distance * DistanceScale), 0, int64(MaxQuantizedDistance)));
+}
+
+int16 QuantizeSigned(float Value, float Scale) {
+  return static_cast<int16>(FMath::Clamp<int32>(FMath::RoundToInt(Value * Scale), MIN_int16, MAX_int16));
+}
+} // namespace
+
+double FRailsTrainNetState::Extrapolate(double Age) const {
+  if (bStopped || Age <= 0.0) {
+    return Distance;
+  }
+
+  // Braking: stop at zero speed instead of reversing
+  double Time = Age;
+  if (Velocity * Acceleration < 0.0f) {
+    Time = FMath::Min(Time, double(-Velocity / Acceleration));
+  }
+  return Distance + Velocity * Time + 0.5 * Acceleration * Time * Time;
+}
+
+float FRailsTrainNetState::ExtrapolateVelocity(double Age) const {
+  if (bStopped || Age <= 0.0) {
+    return bStopped ? 0.0f : Velocity;
+  }
+
+  double Time = Age;
+  if (Velocity * Acceleration < 0.0f) {
+    Time = FMath::Min(Time, double(-Velocity / Acceleration));
+  }
+  return float(Velocity + Acceleration * Time);
+}
+
+void FRailsTrainNetState::Quantize() {
+  Distance = QuantizeDistance(Distance) / DistanceScale;
+  Velocity = QuantizeSigned(Velocity, VelocityScale) / VelocityScale;
+  Acceleration = QuantizeSigned(Acceleration, AccelerationScale) / AccelerationScale;
+}
+
+bool FRailsTrainNetState::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess) {
+  uint64 QuantizedDistance = 0;
+  int16 QuantizedVelocity = 0;
+  int16 QuantizedAcceleration = 0;
+  uint8 StoppedBit = 0;
+
+  if (Ar.IsSaving()) {
+    QuantizedDistance = QuantizeDistance(Distance);
+    QuantizedVelocity = QuantizeSigned(Velocity, VelocityScale);
+    QuantizedAcceleration = QuantizeSigned(Acceleration, AccelerationScale);
+    StoppedBit = bStopped ? 1 : 0;
+  }
+
+  Ar.SerializeBits(&QuantizedDistance, DistanceBits);
+  Ar << QuantizedVelocity;
+  Ar << QuantizedAcceleration;
+  Ar << ServerTime;
+  Ar.SerializeBits(&StoppedBit, 1);
+
+  if (Ar.IsLoading()) {
+    Distance = QuantizedDistance / DistanceScale;
+    Velocity = QuantizedVelocity / VelocityScale;
+    Acceleration = QuantizedAcceleration / AccelerationScale;
+    bStopped = StoppedBit != 0;
+  }
+
+  bOutSuccess = true;
+  return true;
+}
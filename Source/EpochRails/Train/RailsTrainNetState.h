@@ -0,0 +1,55 @@
+// RailsTrainNetState.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RailsTrainNetState.generated.h"
+
+/**
+ * Everything a client needs to place a train on its path: where it was at a
+ * given server time and how it was moving. Wagon poses are rebuilt locally
+ * from the path, so this is all that replicates per frame for a whole consist.
+ *
+ * Serialized quantised: distance 1/8 cm in 40 bits (over a million km of
+ * route), velocity 1 cm/s, acceleration 1/16 cm/s^2, and the full double
+ * server time so hours into a session extrapolation still lands on the
+ * right centimetre - 137 bits per update.
+ */
+USTRUCT()
+struct EPOCHRAILS_API FRailsTrainNetState {
+  GENERATED_BODY()
+
+  /** Route distance (cm) */
+  UPROPERTY()
+  double Distance = 0.0;
+
+  /** Signed speed along the path (cm/s) */
+  UPROPERTY()
+  float Velocity = 0.0f;
+
+  /** Signed acceleration along the path (cm/s^2) */
+  UPROPERTY()
+  float Acceleration = 0.0f;
+
+  /** Server world time the state was sampled at */
+  UPROPERTY()
+  double ServerTime = 0.0;
+
+  UPROPERTY()
+  bool bStopped = true;
+
+  /** Distance Age seconds after the sample; the train never reverses through zero speed */
+  double Extrapolate(double Age) const;
+
+  /** Velocity Age seconds after the sample, same rules as Extrapolate */
+  float ExtrapolateVelocity(double Age) const;
+
+  /** Round the values to what NetSerialize can represent */
+  void Quantize();
+
+  bool NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess);
+};
+
+template <> struct TStructOpsTypeTraits<FRailsTrainNetState> : public TStructOpsTypeTraitsBase2<FRailsTrainNetState> {
+  enum { WithNetSerializer = true };
+};
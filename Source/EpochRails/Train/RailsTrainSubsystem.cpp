@@ -0,0 +1,140 @@
+// RailsTrainSubsystem.cpp
+
+#include "RailsTrainSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+
+#include "Character/RailsPlayerCharacter.h"
+#include "RailsConsist.h"
+#include "RailsTrain.h"
+
+void URailsTrainSubsystem::RegisterTrain(ARailsTrain *Train) {
+  if (Train) {
+    Trains.AddUnique(Train);
+  }
+}
+
+void URailsTrainSubsystem::UnregisterTrain(ARailsTrain *Train) {
+  Trains.Remove(Train);
+}
+
+void URailsTrainSubsystem::RegisterPassenger(ARailsPlayerCharacter *Character) {
+  if (Character) {
+    Passengers.AddUnique(Character);
+  }
+}
+
+void URailsTrainSubsystem::UnregisterPassenger(ARailsPlayerCharacter *Character) {
+  Passengers.Remove(Character);
+}
+
+TStatId URailsTrainSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(URailsTrainSubsystem, STATGROUP_Tickables);
+}
+
+void URailsTrainSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  // Gather every wagon of every train into one flat job list
+  Jobs.Reset();
+  ActiveConsists.Reset();
+  for (const TWeakObjectPtr<ARailsTrain> &WeakTrain : Trains) {
+    ARailsTrain *Train = WeakTrain.Get();
+    if (!Train || !Train->HasConsistPosesPending()) {
+      continue;
+    }
+
+    FRailsConsist &Consist = Train->GetConsist();
+    ActiveConsists.Add(&Consist);
+    for (int32 i = 0; i < Consist.Num(); ++i) {
+      Jobs.Add({&Consist, i});
+    }
+    Train->ClearConsistPosesPending();
+  }
+
+  // Pure math on read-only path data - safe to spread over the task graph
+  ParallelFor(
+      Jobs.Num(),
+      [this](int32 JobIndex) {
+        const FWagonJob &Job = Jobs[JobIndex];
+        Job.Consist->EvaluatePose(Job.Index);
+      },
+      Jobs.Num() < MinWagonsForParallelUpdate);
+
+  // Component moves must happen on the game thread
+  for (FRailsConsist *Consist : ActiveConsists) {
+    Consist->ApplyPoses();
+  }
+
+  // Every vehicle is in its final place - carry riders along, then check who is riding what
+  for (const TWeakObjectPtr<ARailsTrain> &WeakTrain : Trains) {
+    ARailsTrain *Train = WeakTrain.Get();
+    if (!Train) {
+      continue;
+    }
+    Train->CarryRiders(DeltaTime);
+    if (Train->UsesAnalyticPassengerDetection()) {
+      Train->UpdatePassengerContainment(DeltaTime, Passengers);
+    }
+  }
+
+  UpdateWorldOrigin();
+}
+
+ARailsTrain *URailsTrainSubsystem::FindOriginTrain() const {
+  const APlayerController *Controller = GetWorld()->GetFirstPlayerController();
+  ARailsPlayerCharacter *Character = Controller ? Cast<ARailsPlayerCharacter>(Controller->GetPawn()) : nullptr;
+  if (!Character) {
+    return nullptr;
+  }
+
+  if (ARailsTrain *Controlled = Character->GetControlledTrain()) {
+    return Controlled;
+  }
+  for (const TWeakObjectPtr<ARailsTrain> &WeakTrain : Trains) {
+    ARailsTrain *Train = WeakTrain.Get();
+    if (Train && Train->IsPassengerInside(Character)) {
+      return Train;
+    }
+  }
+  return nullptr;
+}
+
+void URailsTrainSubsystem::UpdateWorldOrigin() {
+  UWorld *World = GetWorld();
+  if (OriginRebaseDistance <= 0.0f || World->GetNetMode() == NM_DedicatedServer) {
+    return;
+  }
+  const AWorldSettings *Settings = World->GetWorldSettings();
+  if (!Settings || !Settings->bEnableWorldOriginRebasing || World->OriginLocation != World->RequestedOriginLocation) {
+    return;
+  }
+
+  ARailsTrain *Train = FindOriginTrain();
+  if (!Train || !Train->GetRoute().IsValid()) {
+    return;
+  }
+  if (Train->GetActorLocation().SizeSquared() < FMath::Square(double(OriginRebaseDistance))) {
+    return;
+  }
+
+  // Ahead along the track rather than at the train, so a long run rebases as rarely as possible.
+  // Train state is route distance and replication never carries world positions, so nothing
+  // networked needs translating.
+  // "Ahead" is the way the train is rolling, or the way the throttle points while it stands
+  const float Velocity = Train->GetTrackVelocity();
+  const double Direction = Velocity != 0.0f ? FMath::Sign(Velocity) : (Train->GetSpeed() < 0.0f ? -1.0 : 1.0);
+
+  const FRailsRoute &Route = Train->GetRoute();
+  const double AheadDistance =
+      FMath::Clamp(Train->GetCurrentSplineDistance() + Direction * OriginRebaseDistance * OriginRebaseLead,
+                   Route.GetStartDistance(), Route.GetEndDistance());
+  const FVector NewOrigin = Route.GetTransformAtDistance(AheadDistance).GetLocation();
+  World->RequestNewWorldOrigin(World->OriginLocation + FIntVector(NewOrigin));
+
+  UE_LOG(LogTemp, Log, TEXT("Rebasing world origin %.0f m ahead of %s"),
+         FMath::Abs(AheadDistance - Train->GetCurrentSplineDistance()) / 100.0, *Train->GetName());
+}
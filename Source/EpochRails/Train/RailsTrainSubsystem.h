@@ -0,0 +1,70 @@
+// RailsTrainSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RailsTrainSubsystem.generated.h"
+
+class ARailsTrain;
+class ARailsPlayerCharacter;
+struct FRailsConsist;
+
+/**
+ * World-wide wagon update.
+ * Trains advance their heads in their own tick; this subsystem then evaluates
+ * the poses of all wagons of all trains in parallel from read-only path data
+ * and applies the resulting transforms in one pass on the game thread.
+ *
+ * Where the world settings allow origin rebasing, the origin also follows the
+ * local player's train: once the train is OriginRebaseDistance away from it,
+ * the origin jumps to a point ahead of the train on its route, keeping the
+ * consist near zero where float rendering and physics are precise.
+ */
+UCLASS()
+class EPOCHRAILS_API URailsTrainSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ===== UTickableWorldSubsystem =====
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+
+  // ===== Registration =====
+
+  void RegisterTrain(ARailsTrain *Train);
+  void UnregisterTrain(ARailsTrain *Train);
+
+  /** Players tested by trains using analytic passenger detection */
+  void RegisterPassenger(ARailsPlayerCharacter *Character);
+  void UnregisterPassenger(ARailsPlayerCharacter *Character);
+
+  /** Below this many wagons in total the evaluation stays on the game thread */
+  int32 MinWagonsForParallelUpdate = 32;
+
+  /** Rebase once the followed train is this far (cm) from the origin; 0 disables rebasing */
+  float OriginRebaseDistance = 500000.0f;
+
+  /** The new origin is placed this fraction of OriginRebaseDistance ahead of the train (in its direction of travel) */
+  float OriginRebaseLead = 0.5f;
+
+  /** Train the world origin follows: the local player's controlled or ridden train */
+  ARailsTrain *FindOriginTrain() const;
+
+private:
+  /** Request a new world origin ahead of the followed train once it strays too far */
+  void UpdateWorldOrigin();
+
+  /** One wagon pose to evaluate this frame */
+  struct FWagonJob {
+    FRailsConsist *Consist = nullptr;
+    int32 Index = 0;
+  };
+
+  TArray<TWeakObjectPtr<ARailsTrain>> Trains;
+  TArray<TWeakObjectPtr<ARailsPlayerCharacter>> Passengers;
+
+  /** Reused between frames to avoid reallocating */
+  TArray<FWagonJob> Jobs;
+  TArray<FRailsConsist *> ActiveConsists;
+};
@@ -8,11 +8,22 @@
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/FloatingPawnMovement.h"
 
+#include "RailsSplinePath.h"
 #include "RailsTrain.h"
 
-ARailsWagon::ARailsWagon() {
+FName ARailsWagon::MovementComponentName(TEXT("Movement"));
+FName ARailsWagon::PlatformTriggerComponentName(TEXT("PlatformTrigger"));
+FName ARailsWagon::BuildableZoneComponentName(TEXT("BuildableZone"));
+
+ARailsWagon::ARailsWagon(const FObjectInitializer &ObjectInitializer) : Super(ObjectInitializer) {
   PrimaryActorTick.bCanEverTick = true;
 
+  // Every machine builds its own wagons from the train's replicated layout. Clients cannot
+  // resolve a non-replicated attach parent, so replicated structures riding the wagon are
+  // attached locally from the train's structure description (ApplyStructureDescription).
+  bReplicates = false;
+  SetReplicatingMovement(false);
+
   // Root component
   Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
   SetRootComponent(Root);
@@ -24,27 +35,28 @@ ARailsWagon::ARailsWagon() {
   PlatformMesh->SetCollisionProfileName(TEXT("BlockAll"));
 
   // Movement component
-  Movement = CreateDefaultSubobject<UFloatingPawnMovement>(TEXT("Movement"));
-  Movement->UpdatedComponent = Root;
+  Movement = CreateOptionalDefaultSubobject<UFloatingPawnMovement>(MovementComponentName);
+  if (Movement) {
+    Movement->UpdatedComponent = Root;
+  }
 
   // Platform trigger for detecting players
-  PlatformTrigger = CreateDefaultSubobject<UBoxComponent>(TEXT("PlatformTrigger"));
-  PlatformTrigger->SetupAttachment(Root);
-  PlatformTrigger->SetBoxExtent(FVector(200.0f, 100.0f, 150.0f));
-  PlatformTrigger->SetRelativeLocation(FVector(0.0f, 0.0f, 150.0f));
-  PlatformTrigger->SetCollisionProfileName(TEXT("Trigger"));
-  PlatformTrigger->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-  PlatformTrigger->SetCollisionResponseToAllChannels(ECR_Ignore);
-  PlatformTrigger->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+  PlatformTrigger = CreateOptionalDefaultSubobject<UBoxComponent>(PlatformTriggerComponentName);
+  if (PlatformTrigger) {
+    PlatformTrigger->SetupAttachment(Root);
+    ConfigurePlatformTrigger(PlatformTrigger);
+  }
 
   // Buildable zone visualization
-  BuildableZone = CreateDefaultSubobject<UBoxComponent>(TEXT("BuildableZone"));
-  BuildableZone->SetupAttachment(Root);
-  BuildableZone->SetBoxExtent(FVector(PlatformSize.X * 0.5f, PlatformSize.Y * 0.5f, MaxBuildHeight * 0.5f));
-  BuildableZone->SetRelativeLocation(FVector(0.0f, 0.0f, MaxBuildHeight * 0.5f));
-  BuildableZone->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-  BuildableZone->SetHiddenInGame(true);
-  BuildableZone->ShapeColor = FColor::Green;
+  BuildableZone = CreateOptionalDefaultSubobject<UBoxComponent>(BuildableZoneComponentName);
+  if (BuildableZone) {
+    BuildableZone->SetupAttachment(Root);
+    BuildableZone->SetBoxExtent(FVector(PlatformSize.X * 0.5f, PlatformSize.Y * 0.5f, MaxBuildHeight * 0.5f));
+    BuildableZone->SetRelativeLocation(FVector(0.0f, 0.0f, MaxBuildHeight * 0.5f));
+    BuildableZone->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    BuildableZone->SetHiddenInGame(true);
+    BuildableZone->ShapeColor = FColor::Green;
+  }
 
   // Coupler attachment points
   FrontCoupler = CreateDefaultSubobject<USceneComponent>(TEXT("FrontCoupler"));
@@ -56,14 +68,52 @@ ARailsWagon::ARailsWagon() {
   RearCoupler->SetRelativeLocation(FVector(-PlatformSize.X * 0.5f - 25.0f, 0.0f, 0.0f));
 }
 
+void ARailsWagon::ConfigurePlatformTrigger(UBoxComponent *Trigger) {
+  Trigger->SetBoxExtent(FVector(200.0f, 100.0f, 150.0f));
+  Trigger->SetRelativeLocation(FVector(0.0f, 0.0f, 150.0f));
+  Trigger->SetCollisionProfileName(TEXT("Trigger"));
+  Trigger->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+  Trigger->SetCollisionResponseToAllChannels(ECR_Ignore);
+  Trigger->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
+}
+
+void ARailsWagon::PostInitializeComponents() {
+  Super::PostInitializeComponents();
+
+  RebuildOccupancyGrid();
+}
+
 void ARailsWagon::BeginPlay() {
   Super::BeginPlay();
+
+  // Captured before kinematic movement turns the trigger absolute
+  if (PlatformTrigger) {
+    const FVector Extent = PlatformTrigger->GetScaledBoxExtent();
+    PassengerVolume = FBox(-Extent, Extent).TransformBy(PlatformTrigger->GetRelativeTransform());
+  } else {
+    PassengerVolume = GetBuildableZoneBounds();
+  }
+
+  if (bKinematicMovement) {
+    UPrimitiveComponent *const KinematicTriggers[] = {PlatformTrigger};
+    KinematicMotion.Initialize(*this, KinematicTriggers);
+  }
+}
+
+void ARailsWagon::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  // Destroyed while still coupled - make sure the train's consist drops us
+  if (ARailsTrain *Train = OwningTrain.Get()) {
+    Train->OnWagonEndPlay(this);
+    SetOwningTrain(nullptr);
+  }
+
+  Super::EndPlay(EndPlayReason);
 }
 
 void ARailsWagon::Tick(float DeltaTime) {
   Super::Tick(DeltaTime);
 
-  if (LeaderVehicle.IsValid() && CachedSpline) {
+  if (LeaderVehicle.IsValid() && (CachedPath || CachedSpline)) {
     UpdateMovement(DeltaTime);
   }
 }
@@ -76,28 +126,60 @@ void ARailsWagon::AttachToLeader(AActor *Leader, USplineComponent *Spline) {
     return;
   }
 
-  LeaderVehicle = Leader;
-  CachedSpline = Spline;
-
   // Calculate FollowDistance from coupler positions
-  FollowDistance = CalculateFollowDistance(Leader);
+  const float NewFollowDistance = CalculateFollowDistance(Leader);
 
   // Initialize position behind the leader
-  float LeaderDistance = GetLeaderSplineDistance();
-  CurrentSplineDistance = FMath::Max(0.0f, LeaderDistance - FollowDistance);
+  LeaderVehicle = Leader;
+  const double Distance = FMath::Max(0.0, GetLeaderSplineDistance() - NewFollowDistance);
 
-  // Set initial position on spline
-  FVector InitialLocation = CachedSpline->GetLocationAtDistanceAlongSpline(
-      CurrentSplineDistance, ESplineCoordinateSpace::World);
-  FRotator InitialRotation = CachedSpline->GetRotationAtDistanceAlongSpline(
-      CurrentSplineDistance, ESplineCoordinateSpace::World);
+  ARailsSplinePath *Path = Cast<ARailsSplinePath>(Spline->GetOwner());
+  CachedPath = Path;
+  CachedSpline = Path ? nullptr : Spline;
+  InitializeInConsist(Leader, Path, NewFollowDistance, Distance, GetTransformOnSpline(Distance));
 
-  SetActorLocationAndRotation(InitialLocation, InitialRotation);
+  // Without a train driving the consist we follow the leader ourselves (lean wagons start with tick off)
+  if (!OwningTrain.IsValid()) {
+    SetActorTickEnabled(true);
+  }
 
   UE_LOG(LogTemp, Log, TEXT("Wagon attached to %s (FollowDistance: %.1f, calculated from couplers)"),
          *Leader->GetName(), FollowDistance);
 }
 
+void ARailsWagon::SetLeader(AActor *Leader) {
+  LeaderVehicle = Leader;
+  if (Leader) {
+    FollowDistance = CalculateFollowDistance(Leader);
+  }
+}
+
+void ARailsWagon::InitializeInConsist(AActor *Leader, ARailsSplinePath *Path, double InFollowDistance,
+                                      double SplineDistance, const FTransform &Pose) {
+  LeaderVehicle = Leader;
+  if (Path || !CachedSpline) {
+    // Keep a raw spline from AttachToLeader when there is no path to follow instead
+    CachedPath = Path;
+    CachedSpline = nullptr;
+  }
+  FollowDistance = InFollowDistance;
+  CurrentSplineDistance = SplineDistance;
+
+  // Set initial position on spline
+  SetActorLocationAndRotation(Pose.GetLocation(), Pose.GetRotation());
+  if (KinematicMotion.IsInitialized()) {
+    KinematicMotion.SyncTriggers(*this);
+  }
+}
+
+float ARailsWagon::GetFrontCouplerOffset() const {
+  return FrontCoupler ? FMath::Abs(FrontCoupler->GetRelativeLocation().X) : 0.0f;
+}
+
+float ARailsWagon::GetRearCouplerOffset() const {
+  return RearCoupler ? FMath::Abs(RearCoupler->GetRelativeLocation().X) : 0.0f;
+}
+
 float ARailsWagon::CalculateFollowDistance(AActor *Leader) const {
   if (!Leader || !FrontCoupler) {
     return 500.0f; // Fallback
@@ -138,14 +220,90 @@ void ARailsWagon::Detach() {
 
   LeaderVehicle.Reset();
   CachedSpline = nullptr;
+  CachedPath = nullptr;
   NextWagon.Reset();
+  SetOwningTrain(nullptr);
 
   UE_LOG(LogTemp, Log, TEXT("Wagon detached"));
 }
 
-float ARailsWagon::GetLeaderSplineDistance() const {
+void ARailsWagon::SetOwningTrain(ARailsTrain *Train) {
+  // Move our structure totals (and their replication) over to the new train
+  ARailsTrain *OldTrain = OwningTrain.Get();
+  if (OldTrain != Train) {
+    if (OldTrain) {
+      OldTrain->OnWagonLeft(*this);
+    }
+    OwningTrain = Train;
+    if (Train) {
+      Train->OnWagonJoined(*this);
+    }
+  }
+
+  // Trains with analytic passenger detection test our volume directly
+  if (PlatformTrigger) {
+    PlatformTrigger->SetGenerateOverlapEvents(!Train || !Train->UsesAnalyticPassengerDetection());
+  }
+
+  // The consist moves us in the train's tick - no need for our own
+  SetActorTickEnabled(Train == nullptr);
+}
+
+void ARailsWagon::DeactivateForPool() {
+  Detach();
+
+  // Hand the structures back with their overlaps on; a reused wagon starts at rest
+  SetStructuresRigid(false);
+
+  // Same as when a wagon is destroyed - structures stay in the world, unattached
+  while (Structures.Num() > 0) {
+    const int32 LastIndex = Structures.Num() - 1;
+    AActor *Structure = Structures.GetEntry(LastIndex).Actor.Get();
+    if (!Structure || !RemoveStructure(Structure)) {
+      UntrackStructureAt(LastIndex);
+    }
+  }
+
+  SetActorHiddenInGame(true);
+  SetActorEnableCollision(false);
+  SetActorTickEnabled(false);
+  bIsPooled = true;
+}
+
+void ARailsWagon::ActivateFromPool(const FTransform &Transform) {
+  SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+  SetActorHiddenInGame(false);
+  SetActorEnableCollision(true);
+  CurrentSplineDistance = 0.0;
+  bIsPooled = false;
+
+  if (KinematicMotion.IsInitialized()) {
+    KinematicMotion.SyncTriggers(*this);
+  }
+}
+
+void ARailsWagon::ApplyConsistPose(const FRailsTrackPosition &Position, const FTransform &Pose) {
+  // Crossed onto another segment
+  if (Position.Path != CachedPath) {
+    CachedPath = Position.Path;
+    CachedSpline = nullptr;
+  }
+  CurrentSplineDistance = Position.Distance;
+  bReverseOnPath = Position.bReverse;
+  MoveToPose(Pose);
+}
+
+FRailsTrackPosition ARailsWagon::GetTrackPosition() const {
+  FRailsTrackPosition Position;
+  Position.Path = CachedPath;
+  Position.Distance = CurrentSplineDistance;
+  Position.bReverse = bReverseOnPath;
+  return Position;
+}
+
+double ARailsWagon::GetLeaderSplineDistance() const {
   if (!LeaderVehicle.IsValid()) {
-    return 0.0f;
+    return 0.0;
   }
 
   // Check if leader is a train
@@ -158,36 +316,109 @@ float ARailsWagon::GetLeaderSplineDistance() const {
     return PrevWagon->GetCurrentSplineDistance();
   }
 
-  return 0.0f;
+  return 0.0;
+}
+
+FTransform ARailsWagon::GetTransformOnSpline(double Distance) const {
+  // Prefer the path's baked table, fall back to evaluating the raw spline
+  if (CachedPath) {
+    return CachedPath->GetTransformAtDistance(Distance);
+  }
+  if (CachedSpline) {
+    return FTransform(
+        CachedSpline->GetQuaternionAtDistanceAlongSpline(float(Distance), ESplineCoordinateSpace::World),
+        CachedSpline->GetLocationAtDistanceAlongSpline(float(Distance), ESplineCoordinateSpace::World));
+  }
+  return GetActorTransform();
 }
 
 void ARailsWagon::UpdateMovement(float DeltaTime) {
-  if (!CachedSpline) {
+  if (!CachedPath && !CachedSpline) {
     return;
   }
 
   // Get leader's position on spline
-  float LeaderDistance = GetLeaderSplineDistance();
+  double LeaderDistance = GetLeaderSplineDistance();
 
   // Target position is behind the leader
-  float TargetDistance = FMath::Max(0.0f, LeaderDistance - FollowDistance);
+  double TargetDistance = FMath::Max(0.0, LeaderDistance - FollowDistance);
 
   // Smoothly interpolate to target distance
   CurrentSplineDistance = FMath::FInterpTo(CurrentSplineDistance, TargetDistance, DeltaTime, InterpSpeed);
 
   // Get target location and rotation from spline
-  FVector TargetLocation = CachedSpline->GetLocationAtDistanceAlongSpline(
-      CurrentSplineDistance, ESplineCoordinateSpace::World);
-  FRotator TargetRotation = CachedSpline->GetRotationAtDistanceAlongSpline(
-      CurrentSplineDistance, ESplineCoordinateSpace::World);
+  MoveToPose(GetTransformOnSpline(CurrentSplineDistance));
+}
 
+void ARailsWagon::MoveToPose(const FTransform &Target) {
   // Calculate movement delta
   FVector CurrentLocation = GetActorLocation();
-  FVector Delta = TargetLocation - CurrentLocation;
+  FVector Delta = Target.GetLocation() - CurrentLocation;
+
+  if (bRigidStructuresWhileMoving) {
+    SetStructuresRigid(!Delta.IsNearlyZero());
+  }
+
+  // Defer transform/overlap propagation through attached structures to one pass at scope end
+  FScopedMovementUpdate ScopedMove(GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+  if (KinematicMotion.IsInitialized()) {
+    KinematicMotion.Move(*this, Target, OverlapUpdateInterval);
+    return;
+  }
 
   // Apply movement using FloatingPawnMovement
   FHitResult Hit;
-  Movement->SafeMoveUpdatedComponent(Delta, TargetRotation.Quaternion(), true, Hit);
+  if (Movement) {
+    Movement->SafeMoveUpdatedComponent(Delta, Target.GetRotation(), true, Hit);
+  } else {
+    SetActorLocationAndRotation(Target.GetLocation(), Target.GetRotation(), true, &Hit);
+  }
+}
+
+void ARailsWagon::SetStructuresRigid(bool bRigid) {
+  if (bStructuresRigid == bRigid) {
+    return;
+  }
+  bStructuresRigid = bRigid;
+
+  if (!bRigid) {
+    RestoreStructureOverlaps(nullptr);
+    return;
+  }
+
+  for (const FRailsStructureEntry &Entry : Structures.GetEntries()) {
+    MakeStructureRigid(Entry.Actor.Get());
+  }
+}
+
+void ARailsWagon::MakeStructureRigid(AActor *Structure) {
+  if (!Structure) {
+    return;
+  }
+
+  const TObjectKey<AActor> StructureKey(Structure);
+  Structure->ForEachComponent<UPrimitiveComponent>(true, [this, StructureKey](UPrimitiveComponent *Primitive) {
+    if (Primitive->GetGenerateOverlapEvents()) {
+      Primitive->SetGenerateOverlapEvents(false);
+      RigidOverlapComponents.Add({Primitive, StructureKey});
+    }
+  });
+}
+
+void ARailsWagon::RestoreStructureOverlaps(const AActor *Structure) {
+  // Match on the structure we collected from - child actor components have their own owner
+  const TObjectKey<AActor> StructureKey(Structure);
+  for (int32 i = RigidOverlapComponents.Num() - 1; i >= 0; --i) {
+    if (Structure && RigidOverlapComponents[i].Structure != StructureKey) {
+      continue;
+    }
+    UPrimitiveComponent *Primitive = RigidOverlapComponents[i].Component.Get();
+    if (Primitive) {
+      Primitive->SetGenerateOverlapEvents(true);
+    }
+    RigidOverlapComponents.RemoveAtSwap(i);
+  }
 }
 
 // ===== Structure Placement API =====
@@ -213,11 +444,14 @@ bool ARailsWagon::CanPlaceStructure(const FVector &WorldLocation, const FVector
     return false;
   }
 
-  return true;
+  // Check against already placed structures
+  const FBox Footprint(LocalLocation - FVector(StructureExtent.X, StructureExtent.Y, 0.0f),
+                       LocalLocation + StructureExtent);
+  return OccupancyGrid.IsFree(Footprint);
 }
 
 bool ARailsWagon::PlaceStructure(AActor *Structure) {
-  if (!Structure) {
+  if (!Structure || Structures.Contains(Structure)) {
     return false;
   }
 
@@ -225,31 +459,55 @@ bool ARailsWagon::PlaceStructure(AActor *Structure) {
   Structure->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
 
   // Track for serialization/saving
-  PlacedStructures.Add(Structure);
+  const float Mass = CalculateStructureMass(Structure);
+  TrackStructure(Structure, GetStructureFootprint(Structure), Mass);
+  if (ARailsTrain *Train = OwningTrain.Get()) {
+    Train->OnWagonStructureAdded(Structure->GetClass(), Mass);
+  }
 
   UE_LOG(LogTemp, Log, TEXT("Structure %s placed on wagon"), *Structure->GetName());
   return true;
 }
 
+bool ARailsWagon::TrackStructure(AActor *Structure, const FBox &Footprint, float Mass) {
+  if (!Structures.Add(Structure, Footprint, Mass)) {
+    return false;
+  }
+
+  // Claim the cells under it
+  OccupancyGrid.Add(Footprint);
+  Structure->OnDestroyed.AddUniqueDynamic(this, &ARailsWagon::OnStructureDestroyed);
+
+  // Placed onto a moving wagon - join the rest of the rigid cargo
+  if (bStructuresRigid) {
+    MakeStructureRigid(Structure);
+  }
+
+  if (ARailsTrain *Train = OwningTrain.Get()) {
+    Train->OnWagonStructureTracked(*this, *Structure);
+  }
+  return true;
+}
+
 bool ARailsWagon::RemoveStructure(AActor *Structure) {
   if (!Structure) {
     return false;
   }
 
   // Check if this structure is on this wagon
-  int32 Index = PlacedStructures.IndexOfByPredicate([Structure](const TWeakObjectPtr<AActor> &WeakActor) {
-    return WeakActor.IsValid() && WeakActor.Get() == Structure;
-  });
+  const int32 Index = Structures.IndexOf(Structure);
 
   if (Index == INDEX_NONE) {
     return false;
   }
 
   // Detach from wagon
+  RestoreStructureOverlaps(Structure);
   Structure->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
 
   // Remove from tracking
-  PlacedStructures.RemoveAt(Index);
+  Structure->OnDestroyed.RemoveDynamic(this, &ARailsWagon::OnStructureDestroyed);
+  UntrackStructureAt(Index);
 
   UE_LOG(LogTemp, Log, TEXT("Structure %s removed from wagon"), *Structure->GetName());
   return true;
@@ -257,13 +515,8 @@ bool ARailsWagon::RemoveStructure(AActor *Structure) {
 
 TArray<AActor *> ARailsWagon::GetPlacedStructures() const {
   TArray<AActor *> Result;
-
-  for (const TWeakObjectPtr<AActor> &WeakActor : PlacedStructures) {
-    if (WeakActor.IsValid()) {
-      Result.Add(WeakActor.Get());
-    }
-  }
-
+  Result.Reserve(Structures.Num());
+  ForEachStructure([&Result](AActor &Structure) { Result.Add(&Structure); });
   return Result;
 }
 
@@ -274,3 +527,162 @@ FBox ARailsWagon::GetBuildableZoneBounds() const {
 
   return FBox(Min, Max);
 }
+
+bool ARailsWagon::CanPlaceLayout(const FRailsStructureLayout &Layout) const {
+  const FBox ZoneBounds = GetBuildableZoneBounds();
+
+  // Claim cells in a scratch copy so members are also checked against each other
+  FRailsOccupancyGrid Scratch = OccupancyGrid;
+  for (const FRailsStructureLayoutEntry &Entry : Layout.Entries) {
+    if (!Entry.StructureClass) {
+      return false;
+    }
+
+    // A member whose size cannot be measured cannot be validated either
+    const FBox Footprint = GetLayoutEntryFootprint(Entry);
+    if (!Footprint.IsValid || !ZoneBounds.IsInsideOrOn(Footprint.Min) || !ZoneBounds.IsInsideOrOn(Footprint.Max) ||
+        !Scratch.IsFree(Footprint)) {
+      return false;
+    }
+    Scratch.Add(Footprint);
+  }
+  return true;
+}
+
+FBox ARailsWagon::GetLayoutEntryFootprint(const FRailsStructureLayoutEntry &Entry) {
+  if (Entry.Footprint.IsValid || !Entry.StructureClass) {
+    return Entry.Footprint;
+  }
+
+  // Includes Blueprint-added components, which the CDO itself does not have
+  const FBox ClassBounds = AActor::GetActorClassDefaultComponentsLocalBoundingBox(Entry.StructureClass, true);
+  return ClassBounds.IsValid ? ClassBounds.TransformBy(Entry.RelativeTransform) : ClassBounds;
+}
+
+TArray<AActor *> ARailsWagon::PlaceLayout(const FRailsStructureLayout &Layout, bool bValidate) {
+  TArray<AActor *> Spawned;
+
+  UWorld *World = GetWorld();
+  if (!World || Layout.Entries.Num() == 0) {
+    return Spawned;
+  }
+  if (bValidate && !CanPlaceLayout(Layout)) {
+    UE_LOG(LogTemp, Warning, TEXT("ARailsWagon::PlaceLayout - Layout does not fit on %s"), *GetName());
+    return Spawned;
+  }
+
+  Spawned.Reserve(Layout.Entries.Num());
+  Structures.Reserve(Structures.Num() + Layout.Entries.Num());
+
+  // Accumulate here and hand the train a single update
+  FRailsStructureTotals AddedTotals;
+  const FTransform &WagonTransform = GetActorTransform();
+
+  // Transform and overlap updates of the whole batch are applied once, at the end of the scope
+  FScopedMovementUpdate ScopedMovement(GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+  for (const FRailsStructureLayoutEntry &Entry : Layout.Entries) {
+    if (!Entry.StructureClass) {
+      continue;
+    }
+
+    const FTransform SpawnTransform = Entry.RelativeTransform * WagonTransform;
+    AActor *Structure = World->SpawnActorDeferred<AActor>(Entry.StructureClass, SpawnTransform, this, nullptr,
+                                                          ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!Structure) {
+      continue;
+    }
+
+    // Attach before construction so the structure begins play already riding the wagon.
+    // Blueprint roots only exist after construction and are attached right after it.
+    if (Structure->GetRootComponent()) {
+      Structure->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+    }
+    Structure->FinishSpawning(SpawnTransform);
+    if (Structure->GetAttachParentActor() != this) {
+      Structure->AttachToActor(this, FAttachmentTransformRules::KeepWorldTransform);
+    }
+
+    const FBox Footprint = Entry.Footprint.IsValid ? Entry.Footprint : GetStructureFootprint(Structure);
+    const float Mass = CalculateStructureMass(Structure);
+    if (TrackStructure(Structure, Footprint, Mass)) {
+      AddedTotals.Add(Structure->GetClass(), Mass);
+      Spawned.Add(Structure);
+    }
+  }
+
+  if (ARailsTrain *Train = OwningTrain.Get()) {
+    Train->AddWagonStructureTotals(AddedTotals);
+  }
+
+  UE_LOG(LogTemp, Log, TEXT("Layout placed on %s (%d structures)"), *GetName(), Spawned.Num());
+  return Spawned;
+}
+
+FRailsStructureLayout ARailsWagon::CaptureLayout() const {
+  FRailsStructureLayout Layout;
+  Layout.Entries.Reserve(Structures.Num());
+
+  const FTransform &WagonTransform = GetActorTransform();
+  for (const FRailsStructureEntry &Entry : Structures.GetEntries()) {
+    if (const AActor *Structure = Entry.Actor.Get()) {
+      FRailsStructureLayoutEntry &LayoutEntry = Layout.Entries.AddDefaulted_GetRef();
+      LayoutEntry.StructureClass = Entry.Class;
+      LayoutEntry.RelativeTransform = Structure->GetActorTransform().GetRelativeTransform(WagonTransform);
+      LayoutEntry.Footprint = Entry.Footprint;
+    }
+  }
+  return Layout;
+}
+
+int32 ARailsWagon::CopyLayoutTo(const TArray<ARailsWagon *> &TargetWagons, bool bValidate) const {
+  const FRailsStructureLayout Layout = CaptureLayout();
+
+  int32 NumSpawned = 0;
+  for (ARailsWagon *Target : TargetWagons) {
+    if (Target && Target != this) {
+      NumSpawned += Target->PlaceLayout(Layout, bValidate).Num();
+    }
+  }
+  return NumSpawned;
+}
+
+void ARailsWagon::RebuildOccupancyGrid() {
+  OccupancyGrid.Initialize(GetBuildableZoneBounds(), OccupancyCellSize);
+
+  for (int32 i = 0; i < Structures.Num(); ++i) {
+    if (const AActor *Structure = Structures.GetEntry(i).Actor.Get()) {
+      Structures.SetFootprint(i, GetStructureFootprint(Structure));
+      OccupancyGrid.Add(Structures.GetEntry(i).Footprint);
+    }
+  }
+}
+
+FBox ARailsWagon::GetStructureFootprint(const AActor *Structure) const {
+  const FBox StructureBounds = Structure->CalculateComponentsBoundingBoxInLocalSpace(true);
+  return StructureBounds.TransformBy(Structure->GetActorTransform().GetRelativeTransform(GetActorTransform()));
+}
+
+float ARailsWagon::CalculateStructureMass(const AActor *Structure) {
+  float Mass = 0.0f;
+  Structure->ForEachComponent<UPrimitiveComponent>(false, [&Mass](UPrimitiveComponent *Primitive) {
+    if (Primitive->IsCollisionEnabled()) {
+      Mass += Primitive->CalculateMass();
+    }
+  });
+  return Mass;
+}
+
+void ARailsWagon::UntrackStructureAt(int32 Index) {
+  const FRailsStructureEntry &Entry = Structures.GetEntry(Index);
+  OccupancyGrid.Remove(Entry.Footprint);
+  if (ARailsTrain *Train = OwningTrain.Get()) {
+    Train->OnWagonStructureRemoved(Entry.Class, Entry.Mass);
+    Train->OnWagonStructureUntracked(*this, Entry.Key);
+  }
+  Structures.RemoveAt(Index);
+}
+
+void ARailsWagon::OnStructureDestroyed(AActor *DestroyedActor) {
+  RemoveStructure(DestroyedActor);
+}
@@ -4,12 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "RailsKinematicMotion.h"
+#include "RailsOccupancyGrid.h"
+#include "RailsStructureLayout.h"
+#include "RailsStructureRegistry.h"
+#include "RailsTrackRoute.h"
 #include "RailsWagon.generated.h"
 
 class UFloatingPawnMovement;
 class USplineComponent;
 class UBoxComponent;
 class ARailsTrain;
+class ARailsSplinePath;
 
 /**
  * Base wagon class - a platform that follows the train along the spline.
@@ -20,9 +26,16 @@ class EPOCHRAILS_API ARailsWagon : public APawn {
   GENERATED_BODY()
 
 public:
-  ARailsWagon();
+  ARailsWagon(const FObjectInitializer &ObjectInitializer = FObjectInitializer::Get());
 
+  /** Names of the optional components (subclasses may skip them via DoNotCreateDefaultSubobject) */
+  static FName MovementComponentName;
+  static FName PlatformTriggerComponentName;
+  static FName BuildableZoneComponentName;
+
+  virtual void PostInitializeComponents() override;
   virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
   virtual void Tick(float DeltaTime) override;
 
   // ===== Chain API =====
@@ -31,6 +44,13 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Wagon|Chain")
   void AttachToLeader(AActor *Leader, USplineComponent *Spline);
 
+  /**
+   * Attach with a layout computed by the caller (bulk consist construction).
+   * Same result as AttachToLeader without the per-wagon coupler queries.
+   */
+  void InitializeInConsist(AActor *Leader, ARailsSplinePath *Path, double InFollowDistance, double SplineDistance,
+                           const FTransform &Pose);
+
   /** Detach from the chain */
   UFUNCTION(BlueprintCallable, Category = "Wagon|Chain")
   void Detach();
@@ -41,19 +61,74 @@ public:
 
   /** Get current distance along the spline */
   UFUNCTION(BlueprintPure, Category = "Wagon|Chain")
-  float GetCurrentSplineDistance() const { return CurrentSplineDistance; }
+  double GetCurrentSplineDistance() const { return CurrentSplineDistance; }
 
   /** Set the next wagon in chain */
   UFUNCTION(BlueprintCallable, Category = "Wagon|Chain")
   void SetNextWagon(ARailsWagon *Wagon) { NextWagon = Wagon; }
 
+  /** Couple onto a new leader after the vehicle in front left the chain (follow distance from the couplers) */
+  void SetLeader(AActor *Leader);
+
   /** Get the next wagon in chain */
   UFUNCTION(BlueprintPure, Category = "Wagon|Chain")
   ARailsWagon *GetNextWagon() const { return NextWagon.Get(); }
 
+  /** Get the train whose consist drives this wagon (nullptr if self-ticking) */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Chain")
+  ARailsTrain *GetOwningTrain() const { return OwningTrain.Get(); }
+
+  /**
+   * Hand movement over to a train's consist update (disables this wagon's tick),
+   * or pass nullptr to return to per-wagon ticking.
+   */
+  void SetOwningTrain(ARailsTrain *Train);
+
+  /** Id matching this wagon to its replicated consist entry (0 = none) */
+  uint32 GetConsistNetId() const { return ConsistNetId; }
+  void SetConsistNetId(uint32 Id) { ConsistNetId = Id; }
+
+  // ===== Pooling =====
+
+  /** Hide, disable collision and tick, drop structures and chain links */
+  void DeactivateForPool();
+
+  /** Bring a pooled wagon back at the given transform */
+  void ActivateFromPool(const FTransform &Transform);
+
+  /** True while the wagon sits deactivated in a URailsWagonPool */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Chain")
+  bool IsPooled() const { return bIsPooled; }
+
+  /** Move to a pose computed by the owning train's consist update */
+  void ApplyConsistPose(const FRailsTrackPosition &Position, const FTransform &Pose);
+
+  /** Segment the wagon is on, distance along it and direction of travel */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Chain")
+  FRailsTrackPosition GetTrackPosition() const;
+
+  double GetFollowDistance() const { return FollowDistance; }
+
+  /** Distance from the wagon origin to its front coupler */
+  float GetFrontCouplerOffset() const;
+
+  /** Distance from the wagon origin to its rear coupler */
+  float GetRearCouplerOffset() const;
+
+  float GetCouplingGap() const { return CouplingGap; }
+  float GetInterpSpeed() const { return InterpSpeed; }
+
+  /** Empty mass plus everything built on the wagon (kg) */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Dynamics")
+  float GetMass() const { return EmptyMass + GetStructureMass(); }
+
   // ===== Structure Placement API =====
 
-  /** Check if a structure can be placed at the given world location */
+  /**
+   * Check if a structure can be placed at the given world location: inside the
+   * platform bounds and not overlapping any placed structure (occupancy grid, no traces).
+   * WorldLocation is the centre of the structure's base, StructureExtent its half size in X/Y and height in Z.
+   */
   UFUNCTION(BlueprintCallable, Category = "Wagon|Building")
   bool CanPlaceStructure(const FVector &WorldLocation, const FVector &StructureExtent) const;
 
@@ -65,14 +140,72 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Wagon|Building")
   bool RemoveStructure(AActor *Structure);
 
-  /** Get all structures placed on this wagon */
+  /** Get all structures placed on this wagon (allocates - prefer ForEachStructure in C++) */
   UFUNCTION(BlueprintPure, Category = "Wagon|Building")
   TArray<AActor *> GetPlacedStructures() const;
 
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  bool HasStructure(const AActor *Structure) const { return Structures.Contains(Structure); }
+
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  int32 GetStructureCount() const { return Structures.Num(); }
+
+  /** Total mass of the placed structures (kg) */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  float GetStructureMass() const { return Structures.GetTotals().Mass; }
+
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  int32 GetStructureCountOfClass(TSubclassOf<AActor> StructureClass) const {
+    return Structures.GetTotals().GetCountOfClass(StructureClass);
+  }
+
+  const FRailsStructureRegistry &GetStructureRegistry() const { return Structures; }
+
+  /** Volume (actor space) in which a player counts as riding this wagon */
+  const FBox &GetPassengerVolume() const { return PassengerVolume; }
+
+  /** Visit every live placed structure without allocating */
+  void ForEachStructure(TFunctionRef<void(AActor &)> Func) const {
+    for (const FRailsStructureEntry &Entry : Structures.GetEntries()) {
+      if (AActor *Structure = Entry.Actor.Get()) {
+        Func(*Structure);
+      }
+    }
+  }
+
   /** Get the buildable zone bounds in local space */
   UFUNCTION(BlueprintPure, Category = "Wagon|Building")
   FBox GetBuildableZoneBounds() const;
 
+  // ===== Layout API =====
+
+  /**
+   * Validate a whole layout in one pass: every footprint inside the buildable
+   * zone and free of placed structures and of the layout's other members.
+   * Entries without a footprint are measured from their class defaults.
+   */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  bool CanPlaceLayout(const FRailsStructureLayout &Layout) const;
+
+  /**
+   * Spawn (deferred) and attach every member of the layout in one batch.
+   * Returns the spawned structures; nothing is spawned if validation fails.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Wagon|Building")
+  TArray<AActor *> PlaceLayout(const FRailsStructureLayout &Layout, bool bValidate = true);
+
+  /** Describe the structures currently on this wagon as a layout */
+  UFUNCTION(BlueprintPure, Category = "Wagon|Building")
+  FRailsStructureLayout CaptureLayout() const;
+
+  /** Place this wagon's layout onto each target wagon. Returns the number of structures spawned. */
+  UFUNCTION(BlueprintCallable, Category = "Wagon|Building")
+  int32 CopyLayoutTo(const TArray<ARailsWagon *> &TargetWagons, bool bValidate = true) const;
+
+  /** Re-lay the occupancy grid (call after changing PlatformSize or MaxBuildHeight at runtime) */
+  UFUNCTION(BlueprintCallable, Category = "Wagon|Building")
+  void RebuildOccupancyGrid();
+
 protected:
   // ===== Components =====
 
@@ -83,15 +216,15 @@ protected:
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
   TObjectPtr<UStaticMeshComponent> PlatformMesh = nullptr;
 
-  /** Movement component for smooth interpolated movement */
+  /** Movement component for smooth interpolated movement (optional) */
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
   TObjectPtr<UFloatingPawnMovement> Movement = nullptr;
 
-  /** Trigger for detecting players on the platform */
+  /** Trigger for detecting players on the platform (optional) */
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
   TObjectPtr<UBoxComponent> PlatformTrigger = nullptr;
 
-  /** Visual bounds for the buildable area (editor only) */
+  /** Visual bounds for the buildable area (editor only, optional) */
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
   TObjectPtr<UBoxComponent> BuildableZone = nullptr;
 
@@ -123,9 +256,22 @@ protected:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wagon|Movement")
   float InterpSpeed = 8.0f;
 
+  /** Teleport along the rail instead of sweeping; the platform trigger updates overlaps at a lower rate */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wagon|Movement")
+  bool bKinematicMovement = true;
+
+  /** Seconds between trigger overlap updates while moving kinematically */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wagon|Movement",
+            meta = (ClampMin = "0.0", EditCondition = "bKinematicMovement"))
+  float OverlapUpdateInterval = 0.1f;
+
+  /** Mass of the wagon without structures (kg), used by the train's dynamics */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wagon|Dynamics", meta = (ClampMin = "0.0"))
+  float EmptyMass = 20000.0f;
+
   /** Calculated distance to maintain from the leader (based on coupler positions) */
   UPROPERTY(BlueprintReadOnly, Category = "Wagon|Movement")
-  float FollowDistance = 0.0f;
+  double FollowDistance = 0.0;
 
   // ===== Chain State =====
 
@@ -137,27 +283,110 @@ protected:
   UPROPERTY(BlueprintReadOnly, Category = "Wagon|Chain")
   TWeakObjectPtr<ARailsWagon> NextWagon;
 
-  /** Cached spline component for path following */
+  /** Train updating this wagon as part of its consist */
+  UPROPERTY(BlueprintReadOnly, Category = "Wagon|Chain")
+  TWeakObjectPtr<ARailsTrain> OwningTrain;
+
+  /** Assigned by the server's train, copied from the description on clients */
+  uint32 ConsistNetId = 0;
+
+  /** Raw spline followed when AttachToLeader was given one without an ARailsSplinePath owner */
   UPROPERTY()
   TObjectPtr<USplineComponent> CachedSpline = nullptr;
 
+  /** Path being followed (baked distance lookup, independent of its authoring spline) */
+  UPROPERTY()
+  TObjectPtr<ARailsSplinePath> CachedPath = nullptr;
+
   /** Current distance along the spline */
-  float CurrentSplineDistance = 0.0f;
+  double CurrentSplineDistance = 0.0;
+
+  /** Travelling against CachedPath's spline direction */
+  bool bReverseOnPath = false;
+
+  /** Sweep-free mover used when bKinematicMovement is set */
+  FRailsKinematicMotion KinematicMotion;
 
   // ===== Structures =====
 
-  /** All structures placed on this wagon (use GetPlacedStructures() for Blueprint access) */
-  UPROPERTY()
-  TArray<TWeakObjectPtr<AActor>> PlacedStructures;
+  /**
+   * While the wagon moves, placed structures are treated as rigid cargo:
+   * their components stop generating overlap events until the wagon stops again.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wagon|Building")
+  bool bRigidStructuresWhileMoving = true;
+
+  /** Edge length of the occupancy grid cells used for placement validation */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wagon|Building", meta = (ClampMin = "1.0"))
+  float OccupancyCellSize = 25.0f;
+
+  /** All structures placed on this wagon, with their footprints and totals */
+  FRailsStructureRegistry Structures;
+
+  /** Cells of the buildable zone covered by placed structures */
+  FRailsOccupancyGrid OccupancyGrid;
 
   // ===== Internal Methods =====
 
+  /** Apply the default trigger shape and collision settings */
+  static void ConfigurePlatformTrigger(UBoxComponent *Trigger);
+
   /** Get the leader's current spline distance */
-  float GetLeaderSplineDistance() const;
+  double GetLeaderSplineDistance() const;
 
   /** Calculate follow distance based on coupler positions */
   float CalculateFollowDistance(AActor *Leader) const;
 
+  /** Get world transform at a distance along the cached path */
+  FTransform GetTransformOnSpline(double Distance) const;
+
   /** Update position and rotation based on spline */
   void UpdateMovement(float DeltaTime);
+
+  /** Move the root onto a target pose */
+  void MoveToPose(const FTransform &Target);
+
+  /** Toggle overlap events on placed structures (see bRigidStructuresWhileMoving) */
+  void SetStructuresRigid(bool bRigid);
+
+  /** Disable overlap events on one structure and remember what to restore */
+  void MakeStructureRigid(AActor *Structure);
+
+  /** Restore overlap events disabled by MakeStructureRigid (nullptr = all structures) */
+  void RestoreStructureOverlaps(const AActor *Structure);
+
+  /** Bounds of a structure in wagon local space */
+  FBox GetStructureFootprint(const AActor *Structure) const;
+
+  /** Footprint of a layout entry in wagon local space; measured from the class defaults if not stored */
+  static FBox GetLayoutEntryFootprint(const FRailsStructureLayoutEntry &Entry);
+
+  /** Sum of the structure's physics body masses */
+  static float CalculateStructureMass(const AActor *Structure);
+
+  /** Register an attached structure (registry, grid, destroy hook, rigidity) without notifying the train */
+  bool TrackStructure(AActor *Structure, const FBox &Footprint, float Mass);
+
+  /** Drop a registry entry and everything derived from it (grid cells, train totals) */
+  void UntrackStructureAt(int32 Index);
+
+  /** Release the cells of a structure destroyed while still placed */
+  UFUNCTION()
+  void OnStructureDestroyed(AActor *DestroyedActor);
+
+private:
+  /** Structure components whose overlap events we turned off while moving */
+  struct FRigidOverlapComponent {
+    TWeakObjectPtr<UPrimitiveComponent> Component;
+    /** Placed structure it was collected from (its child actors' components included) */
+    TObjectKey<AActor> Structure;
+  };
+  TArray<FRigidOverlapComponent> RigidOverlapComponents;
+
+  bool bStructuresRigid = false;
+
+  /** Platform trigger shape (or the buildable zone), captured at BeginPlay */
+  FBox PassengerVolume = FBox(ForceInit);
+
+  bool bIsPooled = false;
 };
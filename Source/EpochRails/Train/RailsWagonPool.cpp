@@ -0,0 +1,107 @@
+// RailsWagonPool.cpp
+
+#include "RailsWagonPool.h"
+
+#include "Engine/World.h"
+
+#include "RailsWagon.h"
+
+ARailsWagon *URailsWagonPool::AcquireWagon(TSubclassOf<ARailsWagon> WagonClass,
+                                           const FTransform &Transform, AActor *Owner) {
+  if (ARailsWagon *Wagon = TryAcquirePooledWagon(WagonClass, Transform, Owner)) {
+    return Wagon;
+  }
+  return WagonClass ? SpawnWagon(WagonClass, Transform, Owner) : nullptr;
+}
+
+ARailsWagon *URailsWagonPool::TryAcquirePooledWagon(TSubclassOf<ARailsWagon> WagonClass,
+                                                    const FTransform &Transform, AActor *Owner) {
+  if (!WagonClass) {
+    return nullptr;
+  }
+
+  if (FRailsWagonPoolBucket *Bucket = Buckets.Find(WagonClass)) {
+    while (Bucket->Wagons.Num() > 0) {
+      ARailsWagon *Wagon = Bucket->Wagons.Pop(EAllowShrinking::No);
+      --Stats.Pooled;
+      if (IsValid(Wagon)) {
+        ++Stats.Hits;
+        Wagon->SetOwner(Owner);
+        Wagon->ActivateFromPool(Transform);
+        return Wagon;
+      }
+    }
+  }
+
+  ++Stats.Misses;
+  return nullptr;
+}
+
+void URailsWagonPool::ReleaseWagon(ARailsWagon *Wagon) {
+  if (!IsValid(Wagon)) {
+    return;
+  }
+
+  Wagon->DeactivateForPool();
+  Wagon->SetOwner(nullptr);
+  Buckets.FindOrAdd(Wagon->GetClass()).Wagons.Add(Wagon);
+
+  ++Stats.Releases;
+  ++Stats.Pooled;
+}
+
+void URailsWagonPool::WarmUp(TSubclassOf<ARailsWagon> WagonClass, int32 Count) {
+  if (!WagonClass) {
+    return;
+  }
+
+  FRailsWagonPoolBucket &Bucket = Buckets.FindOrAdd(WagonClass);
+  const int32 ToSpawn = Count - Bucket.Wagons.Num();
+  for (int32 i = 0; i < ToSpawn; ++i) {
+    if (ARailsWagon *Wagon = SpawnWagon(WagonClass, FTransform::Identity, nullptr)) {
+      Wagon->DeactivateForPool();
+      Bucket.Wagons.Add(Wagon);
+      ++Stats.Pooled;
+    }
+  }
+
+  if (ToSpawn > 0) {
+    UE_LOG(LogTemp, Log, TEXT("Wagon pool warmed up with %d x %s"), ToSpawn, *WagonClass->GetName());
+  }
+}
+
+void URailsWagonPool::EmptyPool() {
+  for (TPair<TSubclassOf<ARailsWagon>, FRailsWagonPoolBucket> &Pair : Buckets) {
+    for (ARailsWagon *Wagon : Pair.Value.Wagons) {
+      if (IsValid(Wagon)) {
+        Wagon->Destroy();
+      }
+    }
+  }
+  Buckets.Reset();
+  Stats.Pooled = 0;
+}
+
+int32 URailsWagonPool::GetPooledCount(TSubclassOf<ARailsWagon> WagonClass) const {
+  const FRailsWagonPoolBucket *Bucket = Buckets.Find(WagonClass);
+  return Bucket ? Bucket->Wagons.Num() : 0;
+}
+
+void URailsWagonPool::ResetStats() {
+  const int32 Pooled = Stats.Pooled;
+  Stats = FRailsWagonPoolStats();
+  Stats.Pooled = Pooled;
+}
+
+ARailsWagon *URailsWagonPool::SpawnWagon(TSubclassOf<ARailsWagon> WagonClass,
+                                         const FTransform &Transform, AActor *Owner) const {
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.Owner = Owner;
+  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+  ARailsWagon *Wagon = GetWorld()->SpawnActor<ARailsWagon>(WagonClass, Transform, SpawnParams);
+  if (!Wagon) {
+    UE_LOG(LogTemp, Error, TEXT("URailsWagonPool - Failed to spawn wagon of class %s"), *WagonClass->GetName());
+  }
+  return Wagon;
+}
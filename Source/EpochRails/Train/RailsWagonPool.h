@@ -0,0 +1,90 @@
+// RailsWagonPool.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RailsWagonPool.generated.h"
+
+class ARailsWagon;
+
+/** Counters for pool usage */
+USTRUCT(BlueprintType)
+struct EPOCHRAILS_API FRailsWagonPoolStats {
+  GENERATED_BODY()
+
+  /** Acquires served from the pool */
+  UPROPERTY(BlueprintReadOnly, Category = "Wagon Pool")
+  int32 Hits = 0;
+
+  /** Acquires that had to spawn a new wagon */
+  UPROPERTY(BlueprintReadOnly, Category = "Wagon Pool")
+  int32 Misses = 0;
+
+  /** Wagons returned to the pool */
+  UPROPERTY(BlueprintReadOnly, Category = "Wagon Pool")
+  int32 Releases = 0;
+
+  /** Wagons currently waiting in the pool (all classes) */
+  UPROPERTY(BlueprintReadOnly, Category = "Wagon Pool")
+  int32 Pooled = 0;
+};
+
+/** Deactivated wagons of one class */
+USTRUCT()
+struct FRailsWagonPoolBucket {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<TObjectPtr<ARailsWagon>> Wagons;
+};
+
+/**
+ * Per-class pool of deactivated wagons.
+ * ARailsTrain::AddWagon takes wagons from here and RemoveLastWagon returns them,
+ * so reshaping a consist doesn't spawn/destroy actors or churn the GC.
+ */
+UCLASS()
+class EPOCHRAILS_API URailsWagonPool : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Take a pooled wagon of this exact class, or spawn a new one if none is available */
+  UFUNCTION(BlueprintCallable, Category = "Wagon Pool")
+  ARailsWagon *AcquireWagon(TSubclassOf<ARailsWagon> WagonClass, const FTransform &Transform,
+                            AActor *Owner);
+
+  /** Take a pooled wagon of this exact class; returns nullptr (and counts a miss) if none is available */
+  ARailsWagon *TryAcquirePooledWagon(TSubclassOf<ARailsWagon> WagonClass, const FTransform &Transform,
+                                     AActor *Owner);
+
+  /** Deactivate a wagon (hidden, no collision, no tick) and keep it for reuse */
+  UFUNCTION(BlueprintCallable, Category = "Wagon Pool")
+  void ReleaseWagon(ARailsWagon *Wagon);
+
+  /** Spawn wagons up front until the pool holds at least Count of this class */
+  UFUNCTION(BlueprintCallable, Category = "Wagon Pool")
+  void WarmUp(TSubclassOf<ARailsWagon> WagonClass, int32 Count);
+
+  /** Destroy every pooled wagon */
+  UFUNCTION(BlueprintCallable, Category = "Wagon Pool")
+  void EmptyPool();
+
+  UFUNCTION(BlueprintPure, Category = "Wagon Pool")
+  int32 GetPooledCount(TSubclassOf<ARailsWagon> WagonClass) const;
+
+  UFUNCTION(BlueprintPure, Category = "Wagon Pool")
+  FRailsWagonPoolStats GetStats() const { return Stats; }
+
+  UFUNCTION(BlueprintCallable, Category = "Wagon Pool")
+  void ResetStats();
+
+private:
+  ARailsWagon *SpawnWagon(TSubclassOf<ARailsWagon> WagonClass, const FTransform &Transform,
+                          AActor *Owner) const;
+
+  UPROPERTY()
+  TMap<TSubclassOf<ARailsWagon>, FRailsWagonPoolBucket> Buckets;
+
+  FRailsWagonPoolStats Stats;
+};
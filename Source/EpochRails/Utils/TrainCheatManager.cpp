@@ -5,6 +5,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Train/RailsTrain.h"
 #include "Train/RailsWagon.h"
+#include "Train/RailsWagonPool.h"
 
 void UTrainCheatManager::AddWagons(int32 Count) {
   ARailsTrain *Train = FindNearestTrain();
@@ -14,13 +15,10 @@ void UTrainCheatManager::AddWagons(int32 Count) {
     return;
   }
 
-  int32 Added = 0;
-  for (int32 i = 0; i < Count; ++i) {
-    ARailsWagon *Wagon = Train->AddWagon();
-    if (Wagon) {
-      ++Added;
-    }
-  }
+  // nullptr entries use the train's default wagon class
+  TArray<TSubclassOf<ARailsWagon>> WagonClasses;
+  WagonClasses.SetNum(FMath::Max(Count, 0));
+  const int32 Added = Train->AddWagons(WagonClasses).Num();
 
   FString Msg = FString::Printf(TEXT("Added %d wagon(s) (total: %d)"), Added, Train->GetWagonCount());
   UE_LOG(LogTemp, Log, TEXT("%s"), *Msg);
@@ -55,21 +53,28 @@ void UTrainCheatManager::TrainInfo() {
     return;
   }
 
-  // Count total structures on all wagons
-  int32 TotalStructures = 0;
-  TArray<ARailsWagon *> Wagons = Train->GetAttachedWagons();
-  for (ARailsWagon *Wagon : Wagons) {
-    if (Wagon) {
-      TotalStructures += Wagon->GetPlacedStructures().Num();
-    }
-  }
-
   FString Info = FString::Printf(
-      TEXT("=== TRAIN INFO ===\nSpeed: %.1f\nStopped: %s\nWagons: %d\nStructures: %d"),
+      TEXT("=== TRAIN INFO ===\nSpeed: %.1f\nStopped: %s\nWagons: %d\nStructures: %d (%.0f kg)"),
       Train->GetSpeed(),
       Train->IsStopped() ? TEXT("YES") : TEXT("NO"),
       Train->GetWagonCount(),
-      TotalStructures);
+      Train->GetStructureCount(),
+      Train->GetStructureMass());
+
+  UE_LOG(LogTemp, Log, TEXT("%s"), *Info);
+  GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, Info);
+}
+
+void UTrainCheatManager::WagonPoolStats() {
+  URailsWagonPool *Pool = GetWorld() ? GetWorld()->GetSubsystem<URailsWagonPool>() : nullptr;
+  if (!Pool) {
+    return;
+  }
+
+  const FRailsWagonPoolStats Stats = Pool->GetStats();
+  FString Info = FString::Printf(
+      TEXT("=== WAGON POOL ===\nHits: %d\nMisses: %d\nReleases: %d\nPooled: %d"),
+      Stats.Hits, Stats.Misses, Stats.Releases, Stats.Pooled);
 
   UE_LOG(LogTemp, Log, TEXT("%s"), *Info);
   GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, Info);
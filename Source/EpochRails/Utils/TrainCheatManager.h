@@ -25,6 +25,10 @@ public:
   UFUNCTION(Exec, Category = "Train")
   void TrainInfo();
 
+  /** Print wagon pool hit/miss statistics */
+  UFUNCTION(Exec, Category = "Train")
+  void WagonPoolStats();
+
 private:
   /** Find nearest train to player */
   class ARailsTrain *FindNearestTrain() const;